@@ -0,0 +1,306 @@
+// Headless terrain benchmarks: no window or GL context is created.
+//
+//   terrain_bench --benchmark_out=terrain_bench.json --benchmark_out_format=json
+//
+// Counters: chunks/s (throughput), ns/sample (per height sample) and
+// allocs/chunk (global operator new calls per generated chunk, all threads).
+//
+// BM_ReplayFlyThrough replays the recording named by FLYTHROUGH_RECORDING
+// (saved with 16BitCraft --record-input=<path>) or a built-in scripted flight.
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Chunk.h"
+#include "ChunkConstants.h"
+#include "ChunkManager.h"
+#include "ConfigurableNoise.h"
+#include "FastNoiseLiteWrapper.h"
+#include "InputRecording.h"
+#include "MockChunkFactory.h"
+#include "NoiseConfig.h"
+#include "ScratchArena.h"
+#include "Simulation.h"
+#include "Terrain.h"
+#include "TerrainConstants.h"
+#include "TerrainNoiseFactory.h"
+#include "TerrainThreadPool.h"
+
+namespace {
+    std::atomic<size_t> allocationCount{0};
+}
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+// ScratchArena falls back to aligned new when disabled, so those count too
+void* operator new(std::size_t size, std::align_val_t align) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    size_t alignment = static_cast<size_t>(align);
+    if (void* p = std::aligned_alloc(alignment, (std::max<size_t>(size, 1) + alignment - 1) & ~(alignment - 1))) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+    constexpr int SAMPLES_PER_ITERATION = 1024;
+    constexpr int CHUNK_SAMPLES = (ChunkConstants::SIZE + 1) * (ChunkConstants::SIZE + 1);
+
+    // Generates inline on the calling thread so streaming benchmarks still pay for generation
+    class HeadlessThreadPool : public TerrainThreadPool {
+    public:
+        HeadlessThreadPool() : TerrainThreadPool(0) {}
+        void queueChunkGeneration(std::shared_ptr<Chunk> chunk) override {
+            if (chunk->requestGeneration()) chunk->generate();
+        }
+        void processUploads() override {}
+    };
+
+    struct HeadlessWorld {
+        HeadlessThreadPool threadPool;
+        std::shared_ptr<Terrain> terrain;
+
+        HeadlessWorld() {
+            terrain = std::make_shared<Terrain>(threadPool);
+            terrain->setChunkFactory(std::make_shared<MockChunkFactory>());  // renderingEnabled = false
+            terrain->initialize(std::make_shared<TerrainNoiseFactory>(), nullptr);
+        }
+    };
+
+    // ns/sample is an inverted rate over samples scaled to nanoseconds, so the JSON value is plain ns
+    void setRateCounters(benchmark::State& state, double chunks, double samples, size_t allocations) {
+        state.counters["ns/sample"] = benchmark::Counter(samples * 1e-9,
+            benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+        if (chunks > 0) {
+            state.counters["chunks/s"] = benchmark::Counter(chunks, benchmark::Counter::kIsRate);
+            state.counters["allocs/chunk"] = static_cast<double>(allocations) / chunks;
+        }
+    }
+}
+
+static void BM_TerrainGetHeightAt(benchmark::State& state) {
+    HeadlessWorld world;
+    float offset = 0.0f;
+    for (auto _ : state) {
+        for (int i = 0; i < SAMPLES_PER_ITERATION; ++i) {
+            benchmark::DoNotOptimize(world.terrain->getHeightAt(offset + (i & 31), static_cast<float>(i >> 5)));
+        }
+        offset += 32.0f;
+    }
+    setRateCounters(state, 0.0, static_cast<double>(state.iterations()) * SAMPLES_PER_ITERATION, 0);
+}
+BENCHMARK(BM_TerrainGetHeightAt);
+
+static void BM_ConfigurableNoiseGetNoise(benchmark::State& state) {
+    ConfigurableNoise noise(std::make_shared<FastNoiseLiteWrapper>(), NoiseConfig::Mountains());
+    float offset = 0.0f;
+    for (auto _ : state) {
+        for (int i = 0; i < SAMPLES_PER_ITERATION; ++i) {
+            benchmark::DoNotOptimize(noise.getNoise(offset + (i & 31), static_cast<float>(i >> 5)));
+        }
+        offset += 32.0f;
+    }
+    setRateCounters(state, 0.0, static_cast<double>(state.iterations()) * SAMPLES_PER_ITERATION, 0);
+}
+BENCHMARK(BM_ConfigurableNoiseGetNoise);
+
+static void BM_ChunkGenerate(benchmark::State& state) {
+    HeadlessWorld world;
+    Chunk chunk(3, -2, world.terrain, false);
+
+    size_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        chunk.generate();
+    }
+    size_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+    double chunks = static_cast<double>(state.iterations());
+    setRateCounters(state, chunks, chunks * CHUNK_SAMPLES, allocations);
+}
+BENCHMARK(BM_ChunkGenerate)->Unit(benchmark::kMicrosecond);
+
+// A batch of chunks generated concurrently on a TerrainThreadPool with one worker
+// per hardware thread; Arg(1) uses the per-thread scratch arenas, Arg(0) the global heap
+static void BM_ParallelChunkGenerate(benchmark::State& state) {
+    constexpr int BATCH = 64;
+    HeadlessWorld world;
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    for (int i = 0; i < BATCH; ++i) {
+        chunks.push_back(std::make_shared<Chunk>(i % 8, i / 8, world.terrain, false));
+    }
+
+    ScratchArena::setEnabled(state.range(0) != 0);
+    TerrainThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+    std::mutex doneMutex;
+    std::condition_variable done;
+
+    size_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        std::atomic<int> remaining{BATCH};
+        for (const auto& chunk : chunks) {
+            pool.queueTask([&, chunk = chunk.get()] {
+                chunk->generate();
+                if (remaining.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    done.notify_one();
+                }
+            });
+        }
+        std::unique_lock<std::mutex> lock(doneMutex);
+        done.wait(lock, [&] { return remaining.load() == 0; });
+    }
+    size_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+    ScratchArena::setEnabled(true);
+
+    double generated = static_cast<double>(state.iterations()) * BATCH;
+    setRateCounters(state, generated, generated * CHUNK_SAMPLES, allocations);
+    state.counters["threads"] = static_cast<double>(std::max(1u, std::thread::hardware_concurrency()));
+}
+BENCHMARK(BM_ParallelChunkGenerate)
+    ->ArgName("arena")
+    ->Arg(0)
+    ->Arg(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Walks the player one chunk per update, so each iteration streams in one
+// strip of the view disk (creation + generation) and unloads the trailing edge
+static void BM_ChunkManagerUpdateLoadedChunks(benchmark::State& state) {
+    HeadlessWorld world;
+    ChunkManager manager(world.threadPool, size_t(1) << 40);  // Never evict: measure streaming only
+    manager.setTerrain(world.terrain);
+
+    const float viewDistance = static_cast<float>(state.range(0) * ChunkConstants::SIZE);
+    manager.updateLoadedChunks(glm::vec3(0.0f), viewDistance);
+
+    float playerX = 0.0f;
+    double chunksLoaded = 0.0;
+    size_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        playerX += ChunkConstants::SIZE;
+        manager.updateLoadedChunks(glm::vec3(playerX, 0.0f, 0.0f), viewDistance);
+        chunksLoaded += static_cast<double>(manager.getLastUpdateDelta().loaded.size());
+    }
+    size_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+    setRateCounters(state, chunksLoaded, chunksLoaded * CHUNK_SAMPLES, allocations);
+    state.counters["resident"] = static_cast<double>(manager.getLoadedChunkCount());
+}
+BENCHMARK(BM_ChunkManagerUpdateLoadedChunks)
+    ->Arg(TerrainConstants::VIEW_DISTANCE)
+    ->Unit(benchmark::kMillisecond);
+
+// Gameplay-style ray batch (projectiles, previews, line of sight) over the spawn area;
+// Arg is the worker count, 0 casting everything on the calling thread
+static void BM_TerrainRaycastBatch(benchmark::State& state) {
+    constexpr int RAYS = 512;
+    TerrainThreadPool pool(static_cast<size_t>(state.range(0)));
+    auto terrain = std::make_shared<Terrain>(pool);
+    terrain->setChunkFactory(std::make_shared<MockChunkFactory>());
+    terrain->initialize(std::make_shared<TerrainNoiseFactory>(), nullptr);
+
+    std::vector<Terrain::Ray> rays;
+    for (int i = 0; i < RAYS; ++i) {
+        float x = static_cast<float>((i * 37) % 128) - 64.0f;
+        float z = static_cast<float>((i * 53) % 128) - 64.0f;
+        glm::vec3 dir(std::cos(i * 0.7f), -0.4f, std::sin(i * 0.7f));
+        rays.push_back({glm::vec3(x, terrain->queryHeight(x, z) + 10.0f, z), dir, 100.0f});
+    }
+    std::vector<Terrain::RayHit> hits(rays.size());
+
+    for (auto _ : state) {
+        terrain->raycastBatch(rays.data(), rays.size(), hits.data());
+        benchmark::DoNotOptimize(hits.data());
+    }
+    state.counters["rays/s"] = benchmark::Counter(static_cast<double>(state.iterations()) * RAYS,
+                                                  benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_TerrainRaycastBatch)
+    ->ArgName("workers")
+    ->Arg(0)
+    ->Arg(std::max(1u, std::thread::hardware_concurrency()))
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Streams chunks around the player every CHUNK_UPDATE_STEPS, as Application does every 250 ms
+constexpr uint64_t CHUNK_UPDATE_STEPS = 15;
+
+namespace {
+    void stepAndStream(Simulation& simulation, Terrain& terrain, const SimInput& input) {
+        simulation.step(input);
+        if (simulation.getStepCount() % CHUNK_UPDATE_STEPS == 0) {
+            glm::vec3 pos = simulation.getState().playerPosition;
+            terrain.updateChunksAroundPlayer(pos.x, pos.z);
+        }
+    }
+
+    // Takes off and flies a slow curve for 20 seconds, recorded once so the checksums are real
+    InputRecording scriptedFlyThrough() {
+        HeadlessWorld world;
+        glm::vec3 spawn(8.0f, world.terrain->queryHeight(8.0f, 8.0f) + 20.0f, 8.0f);
+        Simulation simulation(world.terrain, spawn);
+        InputRecording recording;
+        recording.begin(spawn);
+        for (int step = 0; step < 1200; ++step) {
+            SimInput input;
+            input.toggleFly = step == 0;
+            input.forward = step > 0;
+            input.moveSpeed = 30.0f;
+            input.yaw = -90.0f + static_cast<float>(step) * 0.1f;
+            input.pitch = -10.0f;
+            stepAndStream(simulation, *world.terrain, input);
+            recording.append(input, simulation.getChecksum());
+        }
+        return recording;
+    }
+}
+
+// Headless replay of a fly-through: simulation steps plus the chunk streaming they trigger.
+// Every iteration starts from a freshly initialized world so each one streams the same chunks.
+static void BM_ReplayFlyThrough(benchmark::State& state) {
+    InputRecording recording;
+    const char* path = std::getenv("FLYTHROUGH_RECORDING");
+    if (!path || !recording.load(path)) {
+        recording = scriptedFlyThrough();
+    }
+
+    uint64_t chunksLoaded = 0;
+    bool matched = true;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto world = std::make_unique<HeadlessWorld>();
+        Simulation simulation(world->terrain, recording.getSpawnPosition());
+        uint64_t loadedBefore = world->terrain->getStreamingStats().chunksLoaded;
+        state.ResumeTiming();
+
+        for (size_t step = 0; step < recording.size(); ++step) {
+            stepAndStream(simulation, *world->terrain, recording.inputAt(step));
+            matched &= simulation.getChecksum() == recording.checksumAt(step);
+        }
+
+        state.PauseTiming();
+        chunksLoaded = world->terrain->getStreamingStats().chunksLoaded - loadedBefore;
+        world.reset();
+        state.ResumeTiming();
+    }
+    state.counters["steps/s"] = benchmark::Counter(static_cast<double>(state.iterations() * recording.size()),
+                                                   benchmark::Counter::kIsRate);
+    state.counters["chunks/run"] = static_cast<double>(chunksLoaded);
+    state.counters["matched"] = matched ? 1.0 : 0.0;  // 0 means the simulation no longer reproduces the recording
+}
+BENCHMARK(BM_ReplayFlyThrough)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
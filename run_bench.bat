@@ -0,0 +1,28 @@
+set PATH=%PATH%;C:\Users\david\vcpkg\installed\x64-windows\bin
+
+@echo off
+REM Save the current directory
+set CURRENT_DIR=%cd%
+
+REM Navigate to the build directory
+cd build
+
+REM Benchmarks are only meaningful in an optimized build
+cmake --build . --config Release --target terrain_bench
+if %errorlevel% neq 0 (
+    echo Build failed. Exiting.
+    cd %CURRENT_DIR%
+    exit /b %errorlevel%
+)
+
+REM Results go to bench_output.json so runs can be compared between builds
+Release\terrain_bench.exe --benchmark_out=bench_output.json --benchmark_out_format=json
+if %errorlevel% neq 0 (
+    echo Benchmark failed. Exiting.
+    cd %CURRENT_DIR%
+    exit /b %errorlevel%
+)
+
+REM Return to the original directory
+cd %CURRENT_DIR%
+echo Benchmark results written to build\bench_output.json.
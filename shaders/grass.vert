@@ -10,7 +10,13 @@ flat out float instanceID;
 
 void main()
 {
-    instanceID = float(gl_InstanceID);
+    // Seeded by position so a blade keeps its colour when its chunk moves to another slot
+    instanceID = instanceOffset.x * 7.0 + instanceOffset.z * 13.0;
+    // Unused slot entries (GrassRenderer::SENTINEL_Y) are pushed outside the clip volume
+    if (instanceOffset.y < -1.0e8) {
+        gl_Position = vec4(0.0, 0.0, 2.0, 1.0);
+        return;
+    }
     vec3 pos = aPos;
     // sway intensity increases with height (aPos.y)
     float sway = sin(time * 3.0 + instanceOffset.x * 10.0) * 0.02;
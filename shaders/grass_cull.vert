@@ -0,0 +1,9 @@
+#version 330 core
+layout(location = 0) in vec3 instanceOffset;
+
+out vec3 vBase;
+
+void main()
+{
+    vBase = instanceOffset;
+}
@@ -0,0 +1,29 @@
+#version 330 core
+// Draws the blades written by grass_cull.geom, three vertices per blade
+layout(location = 0) in vec4 bladeBase;
+layout(location = 1) in float bladeCorner;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform float time;
+
+flat out float instanceID;
+
+const vec3 corners[3] = vec3[3](
+    vec3(-0.05, 0.0, 0.0),  // bottom left
+    vec3( 0.05, 0.0, 0.0),  // bottom right
+    vec3( 0.0,  0.3, 0.0)   // top point (Y up)
+);
+
+void main()
+{
+    // Seeded by position: the compacted order changes every frame
+    instanceID = bladeBase.x * 7.0 + bladeBase.z * 13.0;
+    vec3 pos = corners[int(bladeCorner + 0.5)];
+    pos.x *= bladeBase.w;
+    // sway intensity increases with height
+    float sway = sin(time * 3.0 + bladeBase.x * 10.0) * 0.02;
+    pos.x += sway * pos.y;
+
+    gl_Position = projection * view * vec4(pos + bladeBase.xyz, 1.0);
+}
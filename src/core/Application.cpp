@@ -12,6 +12,11 @@
 #include "TerrainConstants.h"
 #include "Config.h"
 #include "Debug.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include "ShaderCache.h"
+#include "ShaderLibrary.h"
+#include "StartupTimeline.h"
 #include "WindowManager.h"
 #include "TerrainThreadPool.h"
 
@@ -19,8 +24,6 @@ Application::Application()
     : shouldClose(false)
     , lastFrameTime(0.0f)
     , deltaTime(0.0f)
-    , globTriggered(false)
-    , globHoldTime(0.0f)
     , lastValidHit(0.0f)
     , fKeyMarkerActive(false)
     , windowWidth(0)
@@ -33,6 +36,8 @@ Application::Application()
     windowWidth = config.window.width;
     windowHeight = config.window.height;
 
+    StartupTimeline& timeline = StartupTimeline::getInstance();
+    double windowStartMs = timeline.nowMs();
     if (!initializeGLFW()) {
         Debug::logError("Failed to initialize GLFW");
         throw std::runtime_error("Failed to initialize GLFW");
@@ -44,29 +49,40 @@ Application::Application()
         glfwTerminate();
         throw std::runtime_error("Failed to initialize GLAD");
     }
+    timeline.record("window + GL context", windowStartMs, timeline.nowMs());
+    ShaderCache::getInstance().initialize(config.graphics.shaderCacheDirectory);
+    submitStartupShaders();
 
     try {
         // Initialize core components
         camera = std::make_unique<Camera>();
-        player = std::make_unique<Player>(camera.get());
-        loadingBar = std::make_unique<LoadingBar>("shaders/ui/loading.vert", "shaders/ui/loading.frag");
+        {
+            STARTUP_PHASE("loading bar");
+            loadingBar = std::make_unique<LoadingBar>("shaders/ui/loading.vert", "shaders/ui/loading.frag");
+        }
         raycaster = std::make_unique<Raycaster>();
+        selectInputMode();
         
         // Initialize terrain with loading bar
-        initializeTerrain();
+        {
+            STARTUP_PHASE("terrain");
+            initializeTerrain();
+        }
+        initializeSimulation();
         
-        // Initialize renderer after terrain
+        // Initialize renderer after terrain; fast boot leaves non-critical renderers for after the first frame
         renderer = std::make_unique<Renderer>(*camera);
-        renderer->initialize(terrain);
-        
-        // Initialize game systems
-        slingshotController = std::make_unique<SlingshotController>();
+        {
+            STARTUP_PHASE("renderer");
+            renderer->initialize(terrain, config.game.fastBoot);
+        }
         
         // Initialize input system
         InputManager::setCamera(camera.get());
         InputManager::setMouseSensitivity(config.input.mouseSensitivity);
         InputManager::setMoveSpeed(config.input.moveSpeed);
-        InputManager::setCameraState(CameraState::Free);  // Set initial state to Free
+        // Set initial state to Free; a replay owns the look direction, so mouse look stays off
+        InputManager::setCameraState(replayingInput ? CameraState::Locked : CameraState::Free);
         
         // Set up callbacks
         initializeCallbacks();
@@ -91,7 +107,10 @@ void Application::cleanupResources()
 {
     // Release resources in reverse order of acquisition
     renderer.reset();
-    player.reset();
+    if (window) {
+        ShaderLibrary::getInstance().clear();  // Programs submitted but never used
+    }
+    simulation.reset();
     camera.reset();
     
     if (window) {
@@ -103,6 +122,28 @@ void Application::cleanupResources()
     Debug::log("Application resources cleaned up");
 }
 
+void Application::submitStartupShaders()
+{
+    STARTUP_PHASE("shader submit");
+    // Everything the first frames use; the driver compiles them while the terrain generates
+    static const char* const startupShaders[][2] = {
+        {"shaders/ui/loading.vert", "shaders/ui/loading.frag"},
+        {"shaders/terrain.vert", "shaders/terrain.frag"},
+        {"shaders/reticle.vert", "shaders/reticle.frag"},
+        {"shaders/sky_gradient_vertex.glsl", "shaders/sky_gradient_fragment.glsl"},
+        {"shaders/arm.vert", "shaders/arm.frag"},
+        {"shaders/grass.vert", "shaders/grass.frag"},
+        {"shaders/debug_marker.vert", "shaders/debug_marker.frag"},
+        {"shaders/grid_vertex.glsl", "shaders/grid_fragment.glsl"},
+    };
+
+    ShaderLibrary& library = ShaderLibrary::getInstance();
+    library.initialize();
+    for (const auto& paths : startupShaders) {
+        library.submit(paths[0], paths[1]);
+    }
+}
+
 bool Application::initializeGLFW()
 {
     Debug::log("Initializing GLFW...");
@@ -183,8 +224,10 @@ void Application::handleInput()
         shouldClose = true;
     }
 
-    // Handle regular input
-    InputManager::processKeyboard(window, *player);
+    // Handle regular input; a replay takes every step's input from the recording
+    if (!replayingInput) {
+        InputManager::sampleInput(window, pendingInput);
+    }
     InputManager::handleDebugKeys(window);
 }
 
@@ -192,6 +235,20 @@ void Application::initializeTerrain() {
     // Create terrain with thread pool
     terrain = std::make_shared<Terrain>(*terrainThreadPool);
     loadingBar->initialize();
+
+    // Reuse heightfields generated in previous sessions
+    Config& config = Config::getInstance();
+    if (config.game.chunkCacheEnabled) {
+        terrain->enableChunkCache(config.game.chunkCacheDirectory);
+    }
+    // Recorded and replayed sessions both start from unedited terrain and keep their edits in
+    // memory, so saved edits can't skew the checksums; a replay also leaves the cache as it found it
+    if (replayingInput || recordingInput) {
+        terrain->setChunkCacheWriteBack(!replayingInput);
+    } else if (!config.game.terrainEditDirectory.empty()) {
+        terrain->enableEditLog(config.game.terrainEditDirectory);
+    }
+    terrain->setMemoryBudget(static_cast<size_t>(std::max(config.game.terrainMemoryBudgetMB, 1)) << 20);
     
     auto noiseFactory = std::make_shared<TerrainNoiseFactory>();
     terrain->initialize(noiseFactory, [this](float progress) {
@@ -203,29 +260,117 @@ void Application::initializeTerrain() {
     });
     
     // Set initial player position based on terrain height
-    if (player && camera) {
-        float terrainY = terrain->getHeightAt(camera->getPosition().x, camera->getPosition().z);
+    if (camera) {
+        float terrainY = terrain->queryHeight(camera->getPosition().x, camera->getPosition().z);
         glm::vec3 newPos = camera->getPosition();
         newPos.y = terrainY + 20.0f;
         camera->setPosition(newPos);
     }
 }
 
-void Application::updateGame(float dt) {
-    if (!player || !camera) return;
-    
-    // Update player with terrain height
-    glm::vec3 pos = camera->getPosition();
-    float terrainHeight = terrain ? terrain->getHeightAt(pos.x, pos.z) : 0.0f;
-    player->update(dt, terrainHeight);
-    
-    // Update slingshot controller
-    if (slingshotController) {
-        slingshotController->update(window, *camera, *player);
+void Application::selectInputMode() {
+    Config& config = Config::getInstance();
+    if (!config.game.inputReplayPath.empty()) {
+        if (inputRecording.load(config.game.inputReplayPath) && !inputRecording.empty()) {
+            replayingInput = true;
+            Debug::log("[Replay] Playing " + std::to_string(inputRecording.size()) + " steps");
+        } else {
+            Debug::logError("[Replay] Nothing to replay; starting a normal session");
+        }
+    }
+    recordingInput = !replayingInput && !config.game.inputRecordPath.empty();
+}
+
+void Application::initializeSimulation() {
+    glm::vec3 spawn = camera->getPosition();
+    if (replayingInput) {
+        spawn = inputRecording.getSpawnPosition();
+        camera->setPosition(spawn);
+    } else if (recordingInput) {
+        inputRecording.begin(spawn);
+    }
+
+    simulation = std::make_unique<Simulation>(terrain, spawn);
+}
+
+void Application::stepSimulation() {
+    PROFILE_SCOPE("Application::stepSimulation");
+    if (replayingInput) {
+        stepReplay();
+        return;
+    }
+
+    simulation->step(pendingInput);
+    if (recordingInput) {
+        inputRecording.append(pendingInput, simulation->getChecksum());
+    }
+    pendingInput.clearEdges();
+}
+
+void Application::stepReplay() {
+    if (replayCursor >= inputRecording.size()) {
+        shouldClose = true;
+        return;
+    }
+
+    const SimInput& input = inputRecording.inputAt(replayCursor);
+    simulation->step(input);
+    // Steps never read chunk meshes, so any mismatch is a determinism bug rather than streaming timing
+    if (simulation->getChecksum() != inputRecording.checksumAt(replayCursor)) {
+        replayMetrics.markDivergence(replayCursor);
+    }
+    camera->updateDirection(input.yaw, input.pitch);
+    ++replayCursor;
+}
+
+void Application::finishReplay() {
+    if (!replayingInput || replayReported) return;
+    replayReported = true;
+
+    const Terrain::StreamingStats& streaming = terrain->getStreamingStats();
+    replayMetrics.finish(simulation->getStepCount(), streaming.chunksLoaded, streaming.chunksUnloaded,
+                         streaming.updates, terrain->getResidentChunkBytes());
+    Debug::log(replayMetrics.formatReport());
+    const std::string& path = Config::getInstance().game.replayReportPath;
+    if (!path.empty()) {
+        replayMetrics.exportJson(path);
+    }
+}
+
+void Application::applySimulationState(float alpha) {
+    // The camera keeps its per-frame mouse look; only the position comes from the simulation
+    Simulation::State state = simulation->interpolate(alpha);
+    camera->setPosition(state.playerPosition);
+
+    std::vector<glm::vec3> globPositions;
+    globPositions.reserve(state.globs.size());
+    for (const auto& glob : state.globs) {
+        globPositions.push_back(glob.position);
     }
-    
-    // Update arm renderer
     if (renderer) {
+        renderer->setGlobPositions(std::move(globPositions));
+    }
+
+    // Mouse look stays off while the slingshot charges
+    bool charging = simulation->isSlingshotCharging();
+    if (charging && !slingshotLockedCamera && InputManager::getCameraState() == CameraState::Free) {
+        InputManager::setCameraState(CameraState::Disabled);
+        slingshotLockedCamera = true;
+    } else if (!charging && slingshotLockedCamera) {
+        // Only reset camera state if we were the ones who disabled it
+        if (InputManager::getCameraState() == CameraState::Disabled) {
+            InputManager::setCameraState(CameraState::Free);
+        }
+        slingshotLockedCamera = false;
+    }
+}
+
+void Application::updateFrame(float dt) {
+    PROFILE_SCOPE("Application::updateFrame");
+    if (!camera) return;
+    
+    // Update arm renderer (created after the first frame in fast boot)
+    if (renderer && renderer->getArmRenderer()) {
         renderer->getArmRenderer()->update(dt);
     }
     
@@ -249,56 +394,15 @@ void Application::updateGame(float dt) {
         renderer->showDebugMarker(false);
     }
     
-    // Handle earth glob creation
-    bool rightMouseDown = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS;
-    
-    if (rightMouseDown && !globTriggered) {
-        // Start timing the hold
-        globTriggered = true;
-        globHoldTime = 0.0f;
-    }
-    else if (rightMouseDown && globTriggered) {
-        // Accumulate hold time
-        globHoldTime += dt;
-        
-        // After 3 seconds of holding, perform raycast and create glob
-        if (globHoldTime >= 3.0f) {
-            auto hit = Raycaster::raycastToTerrain(*camera, terrain);
-            if (hit) {
-                lastValidHit = *hit;
-                renderer->beginTerrainLift(lastValidHit);
-                globTriggered = false;
-                globHoldTime = 0.0f;
-            }
-        }
-    }
-    else if (!rightMouseDown && globTriggered) {
-        // Reset if released before threshold
-        globTriggered = false;
-        globHoldTime = 0.0f;
-    }
-    
     // Update terrain with less aggressive spiral pattern
-    static float chunkUpdateAccumulator = 0.0f;
-    static const float chunkUpdateInterval = 0.25f; // 250ms between chunk updates to reduce load
-    
     chunkUpdateAccumulator += dt;
-    if (chunkUpdateAccumulator >= chunkUpdateInterval) {
+    if (chunkUpdateAccumulator >= CHUNK_UPDATE_INTERVAL) {
         chunkUpdateAccumulator = 0.0f;
         
         glm::vec3 pos = camera->getPosition();
         terrain->updateChunksAroundPlayer(pos.x, pos.z);
     }
     
-    // Process chunk uploads with timing control
-    if (terrainThreadPool) {
-        terrainThreadPool->processUploads();
-    }
-    
-    if (renderer) {
-        renderer->updateTerrainManipulator(dt);
-    }
-    
     // Reset input flags
     InputManager::resetActionTriggers();
 }
@@ -306,12 +410,12 @@ void Application::updateGame(float dt) {
 void Application::run() {
     Debug::log("Starting main loop...");
     
-    // Track frame timing for smooth updates
-    const float targetFrameTime = 1.0f / 60.0f;  // Target 60 FPS
+    // Cap deltaTime (below) bounds catch-up to a few steps after a stall
     float accumulator = 0.0f;
     
     while (!shouldClose && !glfwWindowShouldClose(window)) {
-        float currentFrame = static_cast<float>(glfwGetTime());
+        double frameStart = glfwGetTime();
+        float currentFrame = static_cast<float>(frameStart);
         deltaTime = currentFrame - lastFrameTime;
         lastFrameTime = currentFrame;
         
@@ -321,10 +425,19 @@ void Application::run() {
         
         handleInput();
         
-        // Fixed time step update
-        while (accumulator >= targetFrameTime) {
-            updateGame(targetFrameTime);
-            accumulator -= targetFrameTime;
+        if (replayingInput) {
+            // Every frame does the same work on every machine, so frame times compare across runs
+            stepSimulation();
+            applySimulationState(1.0f);
+            updateFrame(Simulation::STEP);
+        } else {
+            // Fixed time step simulation; rendering shows the blend of the last two steps
+            while (accumulator >= Simulation::STEP) {
+                stepSimulation();
+                accumulator -= Simulation::STEP;
+            }
+            applySimulationState(accumulator / Simulation::STEP);
+            updateFrame(deltaTime);
         }
         
         // Process chunk uploads with timing control
@@ -334,12 +447,20 @@ void Application::run() {
             renderer->render();
         }
         
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        {
+            PROFILE_SCOPE("Application::swapBuffers");
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+        }
+        Profiler::getInstance().endFrame();
+        updateStartup();
+        if (replayingInput) {
+            replayMetrics.addFrame((glfwGetTime() - frameStart) * 1000.0, terrainThreadPool->getPendingUploadCount());
+        }
         
-        // Handle FPS limiting if vsync is off
+        // Handle FPS limiting if vsync is off; replays run unthrottled
         Config& config = Config::getInstance();
-        if (!config.window.vsync && config.graphics.maxFPS > 0) {
+        if (!replayingInput && !config.window.vsync && config.graphics.maxFPS > 0) {
             float frameTime = 1.0f / config.graphics.maxFPS;
             float elapsed = static_cast<float>(glfwGetTime()) - currentFrame;
             if (elapsed < frameTime) {
@@ -349,7 +470,7 @@ void Application::run() {
         }
         
         // Display FPS and chunk info if enabled
-        if (Debug::isFPSEnabled()) {
+        if (Debug::isFPSEnabled() || Debug::isDebugInfoEnabled()) {
             static int frameCount = 0;
             static float timeAccumulator = 0.0f;
             
@@ -357,9 +478,18 @@ void Application::run() {
             timeAccumulator += deltaTime;
             
             if (timeAccumulator >= 1.0f) {
-                std::string debugInfo = "FPS: " + std::to_string(frameCount);
-                debugInfo += " | Pending Uploads: " + std::to_string(terrainThreadPool->getPendingUploadCount());
-                Debug::log(debugInfo);
+                if (Debug::isFPSEnabled()) {
+                    std::string debugInfo = "FPS: " + std::to_string(frameCount);
+                    debugInfo += " | Pending Uploads: " + std::to_string(terrainThreadPool->getPendingUploadCount());
+                    Debug::log(debugInfo);
+                    Debug::log(Profiler::getInstance().formatSummary());
+                }
+                if (Debug::isDebugInfoEnabled()) {
+                    // Memory overlay (F3): tracked bytes per category and chunk residency against the budget
+                    Debug::log(MemoryTracker::getInstance().formatSummary());
+                    Debug::log("Resident chunks: " + std::to_string(terrain->getResidentChunkBytes() >> 10) + " KB of " +
+                               std::to_string(Config::getInstance().game.terrainMemoryBudgetMB) + " MB budget");
+                }
                 frameCount = 0;
                 timeAccumulator = 0.0f;
             }
@@ -367,4 +497,31 @@ void Application::run() {
     }
     Debug::log("Main loop ended. shouldClose=" + std::to_string(shouldClose) + 
                ", windowShouldClose=" + std::to_string(glfwWindowShouldClose(window)));
+
+    // A replay cut short (Esc) still reports the frames it ran
+    finishReplay();
+    if (recordingInput) {
+        inputRecording.save(Config::getInstance().game.inputRecordPath);
+    }
+}
+
+void Application::updateStartup() {
+    if (startupReported) return;
+
+    StartupTimeline& timeline = StartupTimeline::getInstance();
+    if (!timeline.hasFirstFrame()) {
+        timeline.markFirstFrame();
+        Debug::log("[Startup] First frame presented after " + std::to_string(static_cast<int>(timeline.getFirstFrameMs())) + " ms");
+    }
+
+    // Fast boot finishes initialization one step per frame after the first one
+    if (renderer && renderer->runDeferredStep()) return;
+
+    startupReported = true;
+    Debug::log(timeline.formatReport());
+    Debug::log(ShaderCache::getInstance().formatStats());  // Includes shaders built by deferred steps
+    const std::string& path = Config::getInstance().game.startupTimelinePath;
+    if (!path.empty()) {
+        timeline.exportTrace(path);
+    }
 }
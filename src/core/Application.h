@@ -3,12 +3,13 @@
 #include <GLFW/glfw3.h>
 #include <memory>
 #include "Camera.h"
+#include "InputRecording.h"
 #include "LoadingBar.h"
 #include "Raycaster.h"
 #include "Renderer.h"
+#include "ReplayMetrics.h"
 #include "Terrain.h"
-#include "Player.h"
-#include "SlingshotController.h"
+#include "Simulation.h"
 #include "Config.h"
 #include "TerrainThreadPool.h"
 
@@ -31,23 +32,39 @@ private:
     bool initializeGLFW();
     bool initializeGLAD();
     void initializeCallbacks();
+    // Starts compiling every startup program so the driver works while the terrain generates
+    void submitStartupShaders();
     void initializeTerrain();
     void updateProjectionMatrix();
     void handleInput();
-    void updateGame(float dt);
+    // Picks replay, recording or live input from the config; runs before the terrain is set up
+    void selectInputMode();
+    // Creates the simulation, at the recording's spawn when replaying
+    void initializeSimulation();
+    // One fixed simulation step on the input sampled so far
+    void stepSimulation();
+    // One step of the loaded recording; closes the window after the last one
+    void stepReplay();
+    // Logs the replay report and writes its JSON, once
+    void finishReplay();
+    // Moves the view to the blend of the last two steps (alpha in [0, 1])
+    void applySimulationState(float alpha);
+    // Per-frame, non-simulation work: arm animation, debug marker, chunk streaming
+    void updateFrame(float dt);
+    // Marks the first frame, drives deferred initialization and reports the startup timeline once
+    void updateStartup();
     void updateChunksAroundPlayer();
     void cleanupResources();
 
     // Core systems
     std::unique_ptr<Camera> camera;
-    std::unique_ptr<Player> player;
+    std::unique_ptr<Simulation> simulation;
     std::unique_ptr<Renderer> renderer;
     std::unique_ptr<Config> config;
     std::shared_ptr<Terrain> terrain;
     std::unique_ptr<TerrainThreadPool> terrainThreadPool;
     
     // Game systems
-    std::unique_ptr<SlingshotController> slingshotController;
     std::unique_ptr<LoadingBar> loadingBar;
     std::unique_ptr<Raycaster> raycaster;
 
@@ -57,10 +74,21 @@ private:
     int windowHeight;
     float lastFrameTime;
     float deltaTime;
-    bool globTriggered;
-    float globHoldTime;
+    SimInput pendingInput;  // Sampled each frame, consumed by the next step
+    bool slingshotLockedCamera = false;
+    static constexpr float CHUNK_UPDATE_INTERVAL = 0.25f; // 250ms between chunk updates to reduce load
+    float chunkUpdateAccumulator = 0.0f;
     glm::vec3 lastValidHit;
     bool fKeyMarkerActive;
+    bool startupReported = false;
+
+    // Input recording and replay
+    InputRecording inputRecording;
+    bool recordingInput = false;
+    bool replayingInput = false;  // Frame-locked: one recorded step per frame, live input ignored
+    size_t replayCursor = 0;
+    ReplayMetrics replayMetrics;
+    bool replayReported = false;
     
     // Window is managed by GLFW, we don't own it
     GLFWwindow* window;
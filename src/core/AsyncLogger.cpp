@@ -0,0 +1,190 @@
+#include "AsyncLogger.h"
+#include <chrono>
+#include <ctime>
+#include <iostream>
+
+namespace {
+    // Set while the singleton exists; Debug falls back to synchronous writes outside that window
+    std::atomic<bool> loggerRunning{false};
+
+    const char* levelName(AsyncLogger::Level level) {
+        switch (level) {
+        case AsyncLogger::Level::Verbose: return "VERBOSE";
+        case AsyncLogger::Level::Info: return "INFO";
+        case AsyncLogger::Level::Warning: return "WARNING";
+        case AsyncLogger::Level::Error: return "ERROR";
+        }
+        return "INFO";
+    }
+
+    // Same layout ctime produced before: "Mon Oct 19 09:47:44 2026"
+    std::string formatTimestamp(uint64_t timestampUs) {
+        std::time_t seconds = static_cast<std::time_t>(timestampUs / 1000000);
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+        char buffer[32];
+        size_t length = std::strftime(buffer, sizeof(buffer), "%a %b %d %H:%M:%S %Y", &local);
+        return std::string(buffer, length);
+    }
+}
+
+AsyncLogger& AsyncLogger::getInstance() {
+    static AsyncLogger instance;
+    return instance;
+}
+
+bool AsyncLogger::isRunning() {
+    return loggerRunning.load(std::memory_order_acquire);
+}
+
+AsyncLogger::AsyncLogger() {
+    for (size_t i = 0; i < QUEUE_CAPACITY; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    writer = std::thread([this] { writerLoop(); });
+    loggerRunning.store(true, std::memory_order_release);
+}
+
+AsyncLogger::~AsyncLogger() {
+    loggerRunning.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        shouldStop.store(true, std::memory_order_relaxed);
+    }
+    wake.notify_all();
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
+
+uint64_t AsyncLogger::nowUs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+void AsyncLogger::write(Level level, uint64_t timestampUs, const std::string& message) {
+    std::ostream& out = level == Level::Error ? std::cerr : std::cout;
+    out << "[" << formatTimestamp(timestampUs) << "] " << levelName(level) << ": " << message << '\n';
+}
+
+bool AsyncLogger::allow(Level level, uint64_t timestampUs) {
+    if (level == Level::Error) return true;
+
+    RateWindow& window = rateWindows[static_cast<size_t>(level)];
+    uint64_t second = timestampUs / 1000000;
+    uint64_t current = window.second.load(std::memory_order_relaxed);
+    if (current != second && window.second.compare_exchange_strong(current, second, std::memory_order_relaxed)) {
+        window.count.store(0, std::memory_order_relaxed);
+    }
+    return window.count.fetch_add(1, std::memory_order_relaxed) < MAX_RECORDS_PER_SECOND;
+}
+
+bool AsyncLogger::push(Level level, std::string message) {
+    uint64_t timestampUs = nowUs();
+    if (!allow(level, timestampUs)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Bounded MPMC queue (Vyukov); each slot's sequence says whose turn it is
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true) {
+        slot = &slots[pos & (QUEUE_CAPACITY - 1)];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);  // Full: the writer is behind
+            return false;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->level = level;
+    slot->timestampUs = timestampUs;
+    slot->message = std::move(message);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    accepted.fetch_add(1, std::memory_order_release);
+
+    if (level == Level::Error) {
+        wake.notify_one();
+    }
+    return true;
+}
+
+bool AsyncLogger::pop(Level& level, uint64_t& timestampUs, std::string& message) {
+    Slot& slot = slots[dequeuePos & (QUEUE_CAPACITY - 1)];
+    size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(dequeuePos + 1) < 0) {
+        return false;
+    }
+
+    level = slot.level;
+    timestampUs = slot.timestampUs;
+    message = std::move(slot.message);
+    slot.message.clear();
+    slot.sequence.store(dequeuePos + QUEUE_CAPACITY, std::memory_order_release);
+    ++dequeuePos;
+    return true;
+}
+
+void AsyncLogger::writerLoop() {
+    uint64_t reportedDrops = 0;
+    Level level = Level::Info;
+    uint64_t timestampUs = 0;
+    std::string message;
+
+    while (true) {
+        uint64_t count = 0;
+        bool wroteError = false;
+        while (pop(level, timestampUs, message)) {
+            write(level, timestampUs, message);
+            wroteError |= level == Level::Error;
+            ++count;
+        }
+
+        uint64_t drops = dropped.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            write(Level::Warning, nowUs(), "[AsyncLogger] Dropped " + std::to_string(drops - reportedDrops) +
+                                           " log records (rate limit or full queue)");
+            reportedDrops = drops;
+        }
+
+        if (count > 0) {
+            std::cout.flush();
+            if (wroteError) std::cerr.flush();
+            written.fetch_add(count, std::memory_order_release);
+            drained.notify_all();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        if (shouldStop.load(std::memory_order_relaxed)) {
+            lock.unlock();
+            // Producers may still have been mid-push; take whatever landed
+            while (pop(level, timestampUs, message)) {
+                write(level, timestampUs, message);
+            }
+            std::cout.flush();
+            std::cerr.flush();
+            return;
+        }
+        wake.wait_for(lock, std::chrono::milliseconds(10));
+    }
+}
+
+void AsyncLogger::flush() {
+    uint64_t target = accepted.load(std::memory_order_acquire);
+    wake.notify_one();
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (written.load(std::memory_order_acquire) < target) {
+        drained.wait_for(lock, std::chrono::milliseconds(5));
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Background log writer behind Debug::log.
+//
+// Callers push records into a bounded lock-free multi-producer queue and return
+// immediately; a single writer thread timestamps, formats and writes them in
+// batches. When the queue is full or a level exceeds its per-second budget the
+// record is dropped and counted instead of blocking the render or worker thread.
+// Errors bypass rate limiting and wake the writer straight away.
+class AsyncLogger {
+public:
+    enum class Level : uint8_t { Verbose, Info, Warning, Error };
+
+    static constexpr size_t QUEUE_CAPACITY = 4096;       // Power of two
+    static constexpr uint32_t MAX_RECORDS_PER_SECOND = 256; // Per level; errors are never limited
+
+    static AsyncLogger& getInstance();
+    // False before first use and once static destruction has begun
+    static bool isRunning();
+
+    // Never blocks; returns false if the record was dropped
+    bool push(Level level, std::string message);
+    // Blocks until everything queued so far has been written
+    void flush();
+
+    uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    // Synchronous formatting used by the writer (and after shutdown)
+    static void write(Level level, uint64_t timestampUs, const std::string& message);
+    static uint64_t nowUs();
+
+    ~AsyncLogger();
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        Level level = Level::Info;
+        uint64_t timestampUs = 0;
+        std::string message;
+    };
+
+    struct RateWindow {
+        std::atomic<uint64_t> second{0};
+        std::atomic<uint32_t> count{0};
+    };
+
+    AsyncLogger();
+    bool allow(Level level, uint64_t timestampUs);
+    bool pop(Level& level, uint64_t& timestampUs, std::string& message);
+    void writerLoop();
+
+    std::array<Slot, QUEUE_CAPACITY> slots;
+    std::atomic<size_t> enqueuePos{0};
+    size_t dequeuePos = 0;  // Writer thread only
+
+    std::array<RateWindow, 3> rateWindows;  // Verbose, Info, Warning
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> accepted{0};
+
+    std::mutex wakeMutex;  // Only used by the writer to sleep and by flush()
+    std::condition_variable wake;
+    std::condition_variable drained;
+    std::atomic<bool> shouldStop{false};
+    std::thread writer;
+};
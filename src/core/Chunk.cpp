@@ -1,4 +1,5 @@
 #include "Chunk.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <glad/glad.h>
@@ -6,21 +7,32 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include "ChunkConstants.h"
 #include "Debug.h"
+#include "GrassSpawner.h"
+#include "GridWalk.h"
+#include "Profiler.h"
+#include "ScratchArena.h"
 #include "Shader.h" // Include Shader to set uniforms
 #include "Terrain.h"
 #include "InputManager.h"
 
 static constexpr int SIZE = ChunkConstants::SIZE;
 
-Chunk::Chunk(int x, int z, std::shared_ptr<Terrain> terrain, bool renderingEnabled) : chunkX(x), chunkZ(z), terrain(std::move(terrain)), spacing(1.0f)
+Chunk::Chunk(int x, int z, const std::shared_ptr<Terrain>& terrain, bool renderingEnabled)
+    : renderingEnabled(renderingEnabled), chunkX(x), chunkZ(z), spacing(1.0f), terrain(terrain.get())
 {
-    generate();
-    if (renderingEnabled)
-        uploadToGPU();
+}
+
+bool Chunk::requestGeneration()
+{
+    State expected = State::Empty;
+    return state.compare_exchange_strong(expected, State::Queued, std::memory_order_acq_rel);
 }
 
 Chunk::~Chunk()
 {
+    // Headless chunks never touched GL
+    if (VAO == 0)
+        return;
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
     glDeleteBuffers(1, &EBO);
@@ -28,29 +40,61 @@ Chunk::~Chunk()
 
 void Chunk::generate()
 {
+    PROFILE_SCOPE("Chunk::generate");
+    std::lock_guard<std::mutex> lock(meshMutex);
     vertices.clear();
     indices.clear();
     normals.clear();
 
+    // Heights are scratch: they live in this thread's arena and are gone after the mesh is built
+    ScratchArena& arena = ScratchArena::forThread();
+    ScratchArena::Scope scratch(arena);
+    ScratchVector<float> heights(&arena);
+    heights.reserve((SIZE + 1) * (SIZE + 1));
+
+    // Cached heightfields skip noise sampling entirely
+    loadedFromCache = terrain->loadCachedHeights(chunkX, chunkZ, heights);
+    if (!loadedFromCache)
+    {
+        heights.resize((SIZE + 1) * (SIZE + 1));
+        for (int z = 0; z <= SIZE; ++z)
+        {
+            for (int x = 0; x <= SIZE; ++x)
+            {
+                float worldX = chunkX * SIZE + static_cast<float>(x);
+                float worldZ = chunkZ * SIZE + static_cast<float>(z);
+                heights[z * (SIZE + 1) + x] = terrain->getHeightAt(worldX, worldZ);
+            }
+        }
+
+        // The cache holds unedited terrain; write-back is asynchronous
+        if (terrain->getChunkCache())
+            terrain->storeCachedHeights(chunkX, chunkZ, heights);
+    }
+
+    // Player edits sit on top of the generated heights
+    terrain->applyHeightEdits(chunkX, chunkZ, heights, &overlaySequence);
+
+    // Grass reuses the heights just sampled; headless chunks never draw it
+    grassInstances.clear();
+    if (renderingEnabled)
+        GrassSpawner::placeInChunk(chunkX, chunkZ, heights.data(), grassInstances);
+
     // 1. Generate vertices: (SIZE + 1) x (SIZE + 1) grid
+    vertices.reserve(heights.size() * 3);
     for (int z = 0; z <= SIZE; ++z)
     {
         for (int x = 0; x <= SIZE; ++x)
         {
-            float worldX = chunkX * SIZE + static_cast<float>(x);
-            float worldZ = chunkZ * SIZE + static_cast<float>(z);
-            // int worldX = chunkX * SIZE + x;
-            // int worldZ = chunkZ * SIZE + z;
-
-            float height = terrain->getHeightAt(worldX, worldZ);
             vertices.push_back(static_cast<float>(x));
-            vertices.push_back(height);
+            vertices.push_back(heights[z * (SIZE + 1) + x]);
             vertices.push_back(static_cast<float>(z));
         }
     }
 
     // 2. Generate indices for two triangles per quad
     int vertsPerRow = SIZE + 1;
+    indices.reserve(static_cast<size_t>(SIZE) * SIZE * 6);
     for (int z = 0; z < SIZE; ++z)
     {
         for (int x = 0; x < SIZE; ++x)
@@ -72,73 +116,414 @@ void Chunk::generate()
         }
     }
 
-    normals.resize(vertices.size(), 0.0f); // Initialize with zeroes
+    normals.resize(vertices.size(), 0.0f);
+    recomputeNormals(0, 0, SIZE, SIZE);
+    updateHeightBounds(0, 0, SIZE, SIZE);
+    dirtyRowBegin = dirtyRowEnd = 0;
 
-    for (size_t i = 0; i < indices.size(); i += 3)
+    cpuBytes.set(vertices.capacity() * sizeof(float) + normals.capacity() * sizeof(float) +
+                 indices.capacity() * sizeof(unsigned int));
+    grassBytes.set(grassInstances.capacity() * sizeof(glm::vec3));
+
+    // An unload that raced with generation wins; a regenerate of an uploaded chunk needs a new upload
+    State current = state.load(std::memory_order_relaxed);
+    while (current != State::Unloaded &&
+           !state.compare_exchange_weak(current, State::Generated, std::memory_order_release)) {
+    }
+}
+
+void Chunk::reset(int x, int z, Terrain* newTerrain, bool newRenderingEnabled)
+{
+    std::lock_guard<std::mutex> lock(meshMutex);
+    chunkX = x;
+    chunkZ = z;
+    terrain = newTerrain;
+    renderingEnabled = newRenderingEnabled;
+    state.store(State::Empty, std::memory_order_relaxed);
+    loadedFromCache = false;
+    overlaySequence = 0;
+    dirtyRowBegin = dirtyRowEnd = 0;
+    editsPending.store(false, std::memory_order_relaxed);
+    grassEditsPending.store(false, std::memory_order_relaxed);
+    // clear() keeps capacity, so the next generate() does not allocate
+    vertices.clear();
+    normals.clear();
+    indices.clear();
+    grassInstances.clear();
+    grassSlot = -1;  // ChunkManager's unload callback already returned it
+}
+
+size_t Chunk::estimateMemoryBytes()
+{
+    const size_t vertexCount = static_cast<size_t>(SIZE + 1) * (SIZE + 1);
+    const size_t indexBytes = static_cast<size_t>(SIZE) * SIZE * 6 * sizeof(unsigned int);
+    const size_t cpu = vertexCount * 6 * sizeof(float) + indexBytes;  // Positions + normals
+    const size_t gpu = vertexCount * 6 * sizeof(float) + indexBytes;  // Interleaved VBO + EBO
+    return cpu + gpu;
+}
+
+// Rebuilds normals for the vertex rectangle [minX, maxX] x [minZ, maxZ] from every
+// triangle touching it; vertices outside the rectangle are left as they are
+void Chunk::recomputeNormals(int minX, int minZ, int maxX, int maxZ)
+{
+    const int vertsPerRow = SIZE + 1;
+    auto inRect = [&](int index) {
+        int x = index % vertsPerRow;
+        int z = index / vertsPerRow;
+        return x >= minX && x <= maxX && z >= minZ && z <= maxZ;
+    };
+
+    for (int z = minZ; z <= maxZ; ++z)
+        for (int x = minX; x <= maxX; ++x)
+            for (int c = 0; c < 3; ++c)
+                normals[(z * vertsPerRow + x) * 3 + c] = 0.0f;
+
+    int quadMinX = std::max(minX - 1, 0), quadMaxX = std::min(maxX, SIZE - 1);
+    int quadMinZ = std::max(minZ - 1, 0), quadMaxZ = std::min(maxZ, SIZE - 1);
+    for (int qz = quadMinZ; qz <= quadMaxZ; ++qz)
     {
-        int i0 = indices[i];
-        int i1 = indices[i + 1];
-        int i2 = indices[i + 2];
+        for (int qx = quadMinX; qx <= quadMaxX; ++qx)
+        {
+            // Same winding as the index buffer built in generate()
+            size_t first = (static_cast<size_t>(qz) * SIZE + qx) * 6;
+            for (size_t i = first; i < first + 6; i += 3)
+            {
+                int i0 = indices[i];
+                int i1 = indices[i + 1];
+                int i2 = indices[i + 2];
+
+                glm::vec3 v0(vertices[i0 * 3], vertices[i0 * 3 + 1], vertices[i0 * 3 + 2]);
+                glm::vec3 v1(vertices[i1 * 3], vertices[i1 * 3 + 1], vertices[i1 * 3 + 2]);
+                glm::vec3 v2(vertices[i2 * 3], vertices[i2 * 3 + 1], vertices[i2 * 3 + 2]);
+                glm::vec3 normal = glm::normalize(glm::cross(v1 - v0, v2 - v0));
+
+                for (int idx : {i0, i1, i2})
+                {
+                    if (!inRect(idx))
+                        continue;
+                    normals[idx * 3 + 0] += normal.x;
+                    normals[idx * 3 + 1] += normal.y;
+                    normals[idx * 3 + 2] += normal.z;
+                }
+            }
+        }
+    }
+
+    for (int z = minZ; z <= maxZ; ++z)
+    {
+        for (int x = minX; x <= maxX; ++x)
+        {
+            size_t i = static_cast<size_t>(z * vertsPerRow + x) * 3;
+            glm::vec3 n = glm::normalize(glm::vec3(normals[i], normals[i + 1], normals[i + 2]));
+            normals[i] = n.x;
+            normals[i + 1] = n.y;
+            normals[i + 2] = n.z;
+        }
+    }
+}
 
-        glm::vec3 v0(vertices[i0 * 3], vertices[i0 * 3 + 1], vertices[i0 * 3 + 2]);
-        glm::vec3 v1(vertices[i1 * 3], vertices[i1 * 3 + 1], vertices[i1 * 3 + 2]);
-        glm::vec3 v2(vertices[i2 * 3], vertices[i2 * 3 + 1], vertices[i2 * 3 + 2]);
+void Chunk::applyHeightDeltas(const std::vector<VertexDelta>& deltas, uint64_t editSequence)
+{
+    PROFILE_SCOPE("Chunk::applyHeightDeltas");
+    std::lock_guard<std::mutex> lock(meshMutex);
+    // generate() already read an overlay that includes this batch
+    if (editSequence <= overlaySequence || vertices.empty() || deltas.empty())
+        return;
 
-        glm::vec3 edge1 = v1 - v0;
-        glm::vec3 edge2 = v2 - v0;
-        glm::vec3 normal = glm::normalize(glm::cross(edge1, edge2));
+    int minX = SIZE, minZ = SIZE, maxX = 0, maxZ = 0;
+    for (const VertexDelta& d : deltas)
+    {
+        if (d.localX < 0 || d.localX > SIZE || d.localZ < 0 || d.localZ > SIZE)
+            continue;
+        vertices[(d.localZ * (SIZE + 1) + d.localX) * 3 + 1] += d.delta;
+        minX = std::min(minX, d.localX);
+        maxX = std::max(maxX, d.localX);
+        minZ = std::min(minZ, d.localZ);
+        maxZ = std::max(maxZ, d.localZ);
+    }
+    if (minX > maxX || minZ > maxZ)
+        return;
 
-        for (int idx : {i0, i1, i2})
+    // Blades stand on lattice vertices, so the ones inside the edit take the new vertex height
+    bool grassMoved = false;
+    for (glm::vec3& blade : grassInstances)
+    {
+        int x = static_cast<int>(std::lround(blade.x)) - chunkX * SIZE;
+        int z = static_cast<int>(std::lround(blade.z)) - chunkZ * SIZE;
+        if (x < minX || x > maxX || z < minZ || z > maxZ)
+            continue;
+        blade.y = vertices[(z * (SIZE + 1) + x) * 3 + 1];
+        grassMoved = true;
+    }
+    if (grassMoved)
+        grassEditsPending.store(true, std::memory_order_release);
+
+    // Neighbouring vertices share the edited triangles, so their normals change too
+    minX = std::max(minX - 1, 0);
+    minZ = std::max(minZ - 1, 0);
+    maxX = std::min(maxX + 1, SIZE);
+    maxZ = std::min(maxZ + 1, SIZE);
+    recomputeNormals(minX, minZ, maxX, maxZ);
+    updateHeightBounds(minX, minZ, maxX, maxZ);
+
+    if (dirtyRowBegin == dirtyRowEnd)
+    {
+        dirtyRowBegin = minZ;
+        dirtyRowEnd = maxZ + 1;
+    }
+    else
+    {
+        dirtyRowBegin = std::min(dirtyRowBegin, minZ);
+        dirtyRowEnd = std::max(dirtyRowEnd, maxZ + 1);
+    }
+    editsPending.store(true, std::memory_order_release);
+}
+
+void Chunk::uploadPendingEdits()
+{
+    if (!editsPending.load(std::memory_order_acquire))
+        return;
+
+    std::lock_guard<std::mutex> lock(meshMutex);
+    if (!isUploaded() || dirtyRowBegin == dirtyRowEnd)
+        return;  // A full upload will pick the edits up
+
+    // Rows are contiguous in the interleaved buffer, so one sub-upload covers the band
+    const int vertsPerRow = SIZE + 1;
+    int firstVertex = dirtyRowBegin * vertsPerRow;
+    int vertexCount = (dirtyRowEnd - dirtyRowBegin) * vertsPerRow;
+    ScratchArena& arena = ScratchArena::forThread();
+    ScratchArena::Scope scratch(arena);
+    ScratchVector<float> vertexData(&arena);
+    packVertexData(firstVertex, vertexCount, vertexData);
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(firstVertex) * 6 * sizeof(float),
+                    static_cast<GLsizeiptr>(vertexData.size() * sizeof(float)), vertexData.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    dirtyRowBegin = dirtyRowEnd = 0;
+    editsPending.store(false, std::memory_order_relaxed);
+}
+
+bool Chunk::takeGrassEdits(std::vector<glm::vec3>& out)
+{
+    if (!grassEditsPending.load(std::memory_order_acquire))
+        return false;
+
+    std::lock_guard<std::mutex> lock(meshMutex);
+    out.assign(grassInstances.begin(), grassInstances.end());
+    grassEditsPending.store(false, std::memory_order_relaxed);
+    return true;
+}
+
+float Chunk::getVertexHeight(int localX, int localZ) const
+{
+    std::lock_guard<std::mutex> lock(meshMutex);
+    size_t index = static_cast<size_t>(localZ * (SIZE + 1) + localX) * 3 + 1;
+    return index < vertices.size() ? vertices[index] : 0.0f;
+}
+
+bool Chunk::sampleHeight(float localX, float localZ, float& height) const
+{
+    std::lock_guard<std::mutex> lock(meshMutex);
+    if (vertices.empty())
+        return false;
+
+    localX = std::clamp(localX, 0.0f, static_cast<float>(SIZE));
+    localZ = std::clamp(localZ, 0.0f, static_cast<float>(SIZE));
+    int x = std::min(static_cast<int>(localX), SIZE - 1);
+    int z = std::min(static_cast<int>(localZ), SIZE - 1);
+    float fx = localX - x;
+    float fz = localZ - z;
+
+    const int vertsPerRow = SIZE + 1;
+    auto heightAt = [&](int cx, int cz) { return vertices[(cz * vertsPerRow + cx) * 3 + 1]; };
+    float topLeft = heightAt(x, z);
+    float topRight = heightAt(x + 1, z);
+    float bottomLeft = heightAt(x, z + 1);
+    float bottomRight = heightAt(x + 1, z + 1);
+
+    // Planar over whichever triangle of the quad's split (top-right to bottom-left) holds the point
+    if (fx + fz <= 1.0f)
+        height = topLeft + fx * (topRight - topLeft) + fz * (bottomLeft - topLeft);
+    else
+        height = bottomRight + (1.0f - fx) * (bottomLeft - bottomRight) + (1.0f - fz) * (topRight - bottomRight);
+    return true;
+}
+
+void Chunk::updateHeightBounds(int minX, int minZ, int maxX, int maxZ)
+{
+    const int vertsPerRow = SIZE + 1;
+    // Tiles share their edge vertices with the neighbouring tile
+    int firstTileX = std::max((minX - 1) / HEIGHT_TILE, 0);
+    int firstTileZ = std::max((minZ - 1) / HEIGHT_TILE, 0);
+    int lastTileX = std::min(maxX / HEIGHT_TILE, HEIGHT_TILES - 1);
+    int lastTileZ = std::min(maxZ / HEIGHT_TILE, HEIGHT_TILES - 1);
+
+    for (int tileZ = firstTileZ; tileZ <= lastTileZ; ++tileZ)
+    {
+        for (int tileX = firstTileX; tileX <= lastTileX; ++tileX)
         {
-            normals[idx * 3 + 0] += normal.x;
-            normals[idx * 3 + 1] += normal.y;
-            normals[idx * 3 + 2] += normal.z;
+            float low = vertices[(tileZ * HEIGHT_TILE * vertsPerRow + tileX * HEIGHT_TILE) * 3 + 1];
+            float high = low;
+            for (int z = tileZ * HEIGHT_TILE; z <= (tileZ + 1) * HEIGHT_TILE; ++z)
+            {
+                for (int x = tileX * HEIGHT_TILE; x <= (tileX + 1) * HEIGHT_TILE; ++x)
+                {
+                    float y = vertices[(z * vertsPerRow + x) * 3 + 1];
+                    low = std::min(low, y);
+                    high = std::max(high, y);
+                }
+            }
+            tileMinY[tileZ * HEIGHT_TILES + tileX] = low;
+            tileMaxY[tileZ * HEIGHT_TILES + tileX] = high;
         }
     }
 
-    // Normalize accumulated normals
-    for (size_t i = 0; i < normals.size(); i += 3)
+    minY = *std::min_element(std::begin(tileMinY), std::end(tileMinY));
+    maxY = *std::max_element(std::begin(tileMaxY), std::end(tileMaxY));
+}
+
+namespace
+{
+    // Moller-Trumbore, double-sided; small tolerances keep rays along shared edges from slipping through
+    bool intersectTriangle(const glm::vec3& origin, const glm::vec3& dir, const glm::vec3& a, const glm::vec3& b,
+                           const glm::vec3& c, float& t)
+    {
+        constexpr float EDGE_EPSILON = 1e-5f;
+        glm::vec3 edge1 = b - a;
+        glm::vec3 edge2 = c - a;
+        glm::vec3 p = glm::cross(dir, edge2);
+        float det = glm::dot(edge1, p);
+        if (std::fabs(det) < 1e-9f)
+            return false;
+
+        float invDet = 1.0f / det;
+        glm::vec3 s = origin - a;
+        float u = glm::dot(s, p) * invDet;
+        if (u < -EDGE_EPSILON || u > 1.0f + EDGE_EPSILON)
+            return false;
+        glm::vec3 q = glm::cross(s, edge1);
+        float v = glm::dot(dir, q) * invDet;
+        if (v < -EDGE_EPSILON || u + v > 1.0f + EDGE_EPSILON)
+            return false;
+        t = glm::dot(edge2, q) * invDet;
+        return true;
+    }
+
+    // The segment's lowest point over [t0, t1] is still above the bound
+    bool passesAbove(float originY, float dirY, float t0, float t1, float boundY)
+    {
+        return std::min(originY + dirY * t0, originY + dirY * t1) > boundY;
+    }
+}
+
+bool Chunk::raycastCell(const glm::vec3& localOrigin, const glm::vec3& dir, int x, int z, float tMin, float tMax,
+                        float& tHit) const
+{
+    const int vertsPerRow = SIZE + 1;
+    auto corner = [&](int cx, int cz) {
+        return glm::vec3(static_cast<float>(cx), vertices[(cz * vertsPerRow + cx) * 3 + 1], static_cast<float>(cz));
+    };
+    glm::vec3 topLeft = corner(x, z);
+    glm::vec3 topRight = corner(x + 1, z);
+    glm::vec3 bottomLeft = corner(x, z + 1);
+    glm::vec3 bottomRight = corner(x + 1, z + 1);
+
+    float cellMaxY = std::max({topLeft.y, topRight.y, bottomLeft.y, bottomRight.y});
+    if (passesAbove(localOrigin.y, dir.y, tMin, tMax, cellMaxY))
+        return false;
+
+    // Same split as the index buffer built in generate()
+    constexpr float T_EPSILON = 1e-4f;
+    bool hit = false;
+    float t = 0.0f;
+    if (intersectTriangle(localOrigin, dir, topLeft, bottomLeft, topRight, t) &&
+        t >= tMin - T_EPSILON && t <= tMax + T_EPSILON)
+    {
+        tHit = t;
+        hit = true;
+    }
+    if (intersectTriangle(localOrigin, dir, topRight, bottomLeft, bottomRight, t) &&
+        t >= tMin - T_EPSILON && t <= tMax + T_EPSILON && (!hit || t < tHit))
+    {
+        tHit = t;
+        hit = true;
+    }
+    return hit;
+}
+
+bool Chunk::raycast(const glm::vec3& origin, const glm::vec3& dir, float tMin, float tMax, float& tHit) const
+{
+    std::lock_guard<std::mutex> lock(meshMutex);
+    if (vertices.empty())
+        return false;
+
+    // Chunk-local space keeps the triangle tests well away from large world coordinates
+    const glm::vec3 local = origin - glm::vec3(chunkX * SIZE, 0.0f, chunkZ * SIZE);
+    if (!clipToRectXZ(local, dir, glm::vec2(0.0f), glm::vec2(static_cast<float>(SIZE)), tMin, tMax))
+        return false;
+    if (passesAbove(local.y, dir.y, tMin, tMax, maxY))
+        return false;
+
+    return walkGridXZ(local, dir, tMin, tMax, static_cast<float>(HEIGHT_TILE),
+        [&](int tileX, int tileZ, float tileEnter, float tileExit) {
+            tileX = std::clamp(tileX, 0, HEIGHT_TILES - 1);
+            tileZ = std::clamp(tileZ, 0, HEIGHT_TILES - 1);
+            if (passesAbove(local.y, dir.y, tileEnter, tileExit, tileMaxY[tileZ * HEIGHT_TILES + tileX]))
+                return false;
+
+            return walkGridXZ(local, dir, tileEnter, tileExit, 1.0f,
+                [&](int x, int z, float cellEnter, float cellExit) {
+                    x = std::clamp(x, tileX * HEIGHT_TILE, (tileX + 1) * HEIGHT_TILE - 1);
+                    z = std::clamp(z, tileZ * HEIGHT_TILE, (tileZ + 1) * HEIGHT_TILE - 1);
+                    return raycastCell(local, dir, x, z, cellEnter, cellExit, tHit);
+                });
+        });
+}
+
+void Chunk::packVertexData(int firstVertex, int vertexCount, ScratchVector<float>& out) const
+{
+    out.clear();
+    out.reserve(static_cast<size_t>(vertexCount) * 6);
+    for (int i = firstVertex; i < firstVertex + vertexCount; ++i)
     {
-        glm::vec3 n(normals[i], normals[i + 1], normals[i + 2]);
-        n = glm::normalize(n);
-        normals[i] = n.x;
-        normals[i + 1] = n.y;
-        normals[i + 2] = n.z;
+        out.push_back(vertices[i * 3]);     // x
+        out.push_back(vertices[i * 3 + 1]); // y
+        out.push_back(vertices[i * 3 + 2]); // z
+        out.push_back(normals[i * 3]);      // nx
+        out.push_back(normals[i * 3 + 1]);  // ny
+        out.push_back(normals[i * 3 + 2]);  // nz
     }
 }
 
 void Chunk::uploadToGPU()
 {
-    
     if (!renderingEnabled)
         return;
-//     std::cout << "[Chunk] First vertex: "
-//           << vertices[0] << ", "
-//           << vertices[1] << ", "
-//           << vertices[2] << std::endl;
-
-// std::cout << "[Chunk] First normal: "
-//           << normals[0] << ", "
-//           << normals[1] << ", "
-//           << normals[2] << std::endl;
-    
-    std::vector<float> vertexData;
-    for (size_t i = 0; i < vertices.size() / 3; ++i)
+
+    std::lock_guard<std::mutex> lock(meshMutex);
+    if (vertices.size() != normals.size())
     {
-        vertexData.push_back(vertices[i * 3]);     // x
-        vertexData.push_back(vertices[i * 3 + 1]); // y
-        vertexData.push_back(vertices[i * 3 + 2]); // z
-        vertexData.push_back(normals[i * 3]);      // nx
-        vertexData.push_back(normals[i * 3 + 1]);  // ny
-        vertexData.push_back(normals[i * 3 + 2]);  // nz
+        Debug::logError("[Chunk] Vertex/normal count mismatch: " + std::to_string(vertices.size()) + " vs " +
+                        std::to_string(normals.size()));
+        return;
+    }
+
+    // Interleaved copy only lives until glBufferData returns
+    ScratchArena& arena = ScratchArena::forThread();
+    ScratchArena::Scope scratch(arena);
+    ScratchVector<float> vertexData(&arena);
+    packVertexData(0, static_cast<int>(vertices.size() / 3), vertexData);
+
+    // Recycled chunks keep their buffer names; glBufferData respecifies the storage
+    if (VAO == 0)
+    {
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+        glGenBuffers(1, &EBO);
     }
-if (vertices.size() != normals.size()) {
-    std::cerr << "[Error] Vertex/normal count mismatch: "
-              << vertices.size() << " vs " << normals.size() << "\n";
-}
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
 
     glBindVertexArray(VAO);
 
@@ -157,7 +542,10 @@ if (vertices.size() != normals.size()) {
     glEnableVertexAttribArray(1);
 
     glBindVertexArray(0);
-    uploaded = true;
+    state.store(State::Uploaded, std::memory_order_release);
+    gpuBytes.set(vertexData.size() * sizeof(float) + indices.size() * sizeof(unsigned int));
+    dirtyRowBegin = dirtyRowEnd = 0;
+    editsPending.store(false, std::memory_order_relaxed);
 }
 
 void Chunk::render(Shader &shader) const
@@ -1,31 +1,115 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include "ChunkConstants.h"
+#include "MemoryTracker.h"
+#include "ScratchArena.h"
 
+class ChunkPool;
 class Shader;
 class Terrain;
 
 class Chunk {
 public:
-    Chunk(int x, int z, std::shared_ptr<Terrain> terrain, bool renderingEnabled = true);
+    // Height change for one vertex of this chunk's (SIZE + 1)^2 grid
+    struct VertexDelta {
+        int localX;
+        int localZ;
+        float delta;
+    };
+
+    // Lifecycle: Empty -> Queued (main thread) -> Generated (worker) -> Uploaded (GL thread).
+    // Unloaded chunks are skipped by whichever step comes next.
+    enum class State : uint8_t { Empty, Queued, Generated, Uploaded, Unloaded };
+
+    // Cheap: no mesh work happens until generate()
+    Chunk(int x, int z, const std::shared_ptr<Terrain>& terrain, bool renderingEnabled = true);
     ~Chunk();
+    // Empty -> Queued; false if generation was already requested (or the chunk was unloaded)
+    bool requestGeneration();
+    void markUnloaded() { state.store(State::Unloaded, std::memory_order_release); }
+    State getState() const { return state.load(std::memory_order_acquire); }
+
     void generate();
     void uploadToGPU();
     void render(Shader& shader) const;
-    bool isUploaded() const { return uploaded; }
+    bool isUploaded() const { return getState() == State::Uploaded; }
+    bool isFromCache() const { return loadedFromCache; }
+
+    // Worker-thread safe: applies deltas newer than the generated overlay and
+    // recomputes normals around the touched vertices only
+    void applyHeightDeltas(const std::vector<VertexDelta>& deltas, uint64_t editSequence);
+    // Main thread: re-uploads the rows changed since the last upload with glBufferSubData
+    void uploadPendingEdits();
+    float getVertexHeight(int localX, int localZ) const;
+    // Height of the drawn surface at a chunk-local position in [0, SIZE]; false before generate()
+    bool sampleHeight(float localX, float localZ, float& height) const;
+
+    // Nearest hit of origin + dir * t against this chunk's triangles for t in [tMin, tMax]
+    // (world space). Skips tiles the segment passes above using the min/max height pyramid.
+    bool raycast(const glm::vec3& origin, const glm::vec3& dir, float tMin, float tMax, float& tHit) const;
+
+    // World-space blade positions placed by generate(); read on the main thread once generated
+    const std::vector<glm::vec3>& getGrassInstances() const { return grassInstances; }
+    // GrassRenderer slot holding this chunk's instances; -1 when not in the instance buffer
+    int getGrassSlot() const { return grassSlot; }
+    void setGrassSlot(int slot) { grassSlot = slot; }
+    // Main thread: copies the blades once applyHeightDeltas has moved some; false when unchanged
+    bool takeGrassEdits(std::vector<glm::vec3>& out);
+
+    // CPU vectors plus GPU buffers as reported to the MemoryTracker
+    size_t getMemoryBytes() const { return cpuBytes.get() + gpuBytes.get(); }
+    // Footprint of a generated, uploaded chunk; used before any chunk has reported
+    static size_t estimateMemoryBytes();
 
 private:
+    friend class ChunkPool;
+
+    Chunk() = default;  // Unplaced; ChunkPool calls reset() before handing it out
+    // Re-targets a recycled chunk: keeps vector capacity and GL buffer names, drops mesh state
+    void reset(int x, int z, Terrain* terrain, bool renderingEnabled);
+
     void drawChunkBoundingBox() const;
+    void recomputeNormals(int minX, int minZ, int maxX, int maxZ);
+    // Refreshes the tiles covering the vertex rectangle, then the chunk bounds
+    void updateHeightBounds(int minX, int minZ, int maxX, int maxZ);
+    bool raycastCell(const glm::vec3& localOrigin, const glm::vec3& dir, int x, int z, float tMin, float tMax,
+                     float& tHit) const;
+    void packVertexData(int firstVertex, int vertexCount, ScratchVector<float>& out) const;
 
-    bool renderingEnabled;
-    bool uploaded = false;
-    int chunkX, chunkZ;
-    float spacing;
-    GLuint VAO, VBO, EBO;
-    std::shared_ptr<Terrain> terrain;
+    bool renderingEnabled = true;
+    std::atomic<State> state{State::Empty};
+    bool loadedFromCache = false;
+    int chunkX = 0, chunkZ = 0;
+    float spacing = 1.0f;
+    GLuint VAO = 0, VBO = 0, EBO = 0;      // Kept across pool reuse; 0 until the first upload
+    Terrain* terrain = nullptr;            // Non-owning: the terrain outlives the chunks it streams
     std::vector<float> vertices;
     std::vector<float> normals;
     std::vector<unsigned int> indices;
+    std::vector<glm::vec3> grassInstances;
+    int grassSlot = -1;                    // Main thread only
+    int poolIndex = -1;                    // Slot in the owning ChunkPool, -1 when not pooled
+
+    // Height pyramid for raycasts: HEIGHT_TILE x HEIGHT_TILE cell tiles, then the whole chunk
+    static constexpr int HEIGHT_TILE = 8;
+    static constexpr int HEIGHT_TILES = ChunkConstants::SIZE / HEIGHT_TILE;
+    float tileMinY[HEIGHT_TILES * HEIGHT_TILES] = {};
+    float tileMaxY[HEIGHT_TILES * HEIGHT_TILES] = {};
+    float minY = 0.0f, maxY = 0.0f;        // Guarded by meshMutex, like the vertices
+
+    mutable std::mutex meshMutex;          // Guards vertices/normals against edit tasks
+    uint64_t overlaySequence = 0;          // Edit batch already baked in by generate()
+    int dirtyRowBegin = 0, dirtyRowEnd = 0; // Vertex rows awaiting re-upload
+    std::atomic<bool> editsPending{false};
+    std::atomic<bool> grassEditsPending{false};
+
+    TrackedBytes cpuBytes{MemoryCategory::ChunkCpu};  // Set under meshMutex by generate()
+    TrackedBytes gpuBytes{MemoryCategory::ChunkGpu};  // Main thread, uploadToGPU()
+    TrackedBytes grassBytes{MemoryCategory::GrassCpu};
 };
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Packs both chunk axes into 64 bits and mixes them (murmur3 finalizer), so
+// neighbouring coords spread across buckets; x ^ (z << 1) collides heavily on grids
+inline std::size_t hashChunkCoord(int x, int z) {
+    uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return static_cast<std::size_t>(key);
+}
+
+// Hash for (chunkX, chunkZ) pairs
+struct ChunkPairHash {
+    std::size_t operator()(const std::pair<int, int>& p) const { return hashChunkCoord(p.first, p.second); }
+};
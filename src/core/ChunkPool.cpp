@@ -0,0 +1,41 @@
+#include "ChunkPool.h"
+#include <atomic>
+#include <utility>
+#include "Chunk.h"
+
+std::shared_ptr<Chunk> ChunkPool::acquire(int x, int z, const std::shared_ptr<Terrain>& terrain, bool renderingEnabled) {
+    for (size_t i = 0; i < released.size(); ++i) {
+        std::shared_ptr<Chunk>& candidate = chunks[released[i]];
+        if (candidate.use_count() != 1) continue;  // Still finishing a generation or upload
+
+        // The last external owner (possibly a worker) released it; see its writes before reuse
+        std::atomic_thread_fence(std::memory_order_acquire);
+        std::swap(released[i], released.back());  // Order is irrelevant, so removal is O(1)
+        released.pop_back();
+        candidate->reset(x, z, terrain.get(), renderingEnabled);
+        ++reusedCount;
+        return candidate;
+    }
+
+    std::shared_ptr<Chunk> chunk(new Chunk());
+    chunk->poolIndex = static_cast<int>(chunks.size());
+    chunk->reset(x, z, terrain.get(), renderingEnabled);
+    chunks.push_back(chunk);
+    return chunk;
+}
+
+void ChunkPool::release(const std::shared_ptr<Chunk>& chunk) {
+    if (!chunk || chunk->poolIndex < 0 || static_cast<size_t>(chunk->poolIndex) >= chunks.size() ||
+        chunks[chunk->poolIndex] != chunk) {
+        return;
+    }
+    released.push_back(chunk->poolIndex);
+}
+
+size_t ChunkPool::getIdleCount() const {
+    size_t idle = 0;
+    for (const auto& chunk : chunks) {
+        idle += chunk.use_count() == 1 ? 1 : 0;
+    }
+    return idle;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class Chunk;
+class Terrain;
+
+// Recycles Chunk objects together with their vertex/normal/index capacity and
+// GL buffer names.
+//
+// The pool keeps one reference to every chunk it has created. Unloaded chunks
+// come back through release() onto a free list, and acquire() takes the first
+// entry whose only remaining owner is the pool (use_count() == 1); a worker or
+// the upload queue may still hold a just-released chunk for a moment. In
+// steady-state streaming, loads and unloads balance, so acquire() allocates
+// nothing and normally stops at the first entry, which it swaps out with the last
+// in O(1). The object count only grows to
+// the peak number of chunks alive at once. Main thread only.
+class ChunkPool {
+public:
+    ChunkPool() = default;
+    ChunkPool(const ChunkPool&) = delete;
+    ChunkPool& operator=(const ChunkPool&) = delete;
+
+    // Returns a chunk placed at (x, z) with empty mesh data; the caller generates it
+    std::shared_ptr<Chunk> acquire(int x, int z, const std::shared_ptr<Terrain>& terrain, bool renderingEnabled);
+    // The chunk left residency; ignored for chunks this pool did not create
+    void release(const std::shared_ptr<Chunk>& chunk);
+
+    size_t getCreatedCount() const { return chunks.size(); }
+    size_t getReusedCount() const { return reusedCount; }
+    size_t getIdleCount() const;  // O(n)
+
+private:
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    std::vector<int> released;  // Pool indices; roughly release order, reuse swaps with the back
+    size_t reusedCount = 0;
+};
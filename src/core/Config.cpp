@@ -41,6 +41,7 @@ void Config::loadFromFile(const std::string& filename) {
             graphics.renderDistance = g.value("renderDistance", graphics.renderDistance);
             graphics.enableVsync = g.value("enableVsync", graphics.enableVsync);
             graphics.maxFPS = g.value("maxFPS", graphics.maxFPS);
+            graphics.shaderCacheDirectory = g.value("shaderCacheDirectory", graphics.shaderCacheDirectory);
         }
 
         // Game config
@@ -49,6 +50,15 @@ void Config::loadFromFile(const std::string& filename) {
             game.chunkSize = g.value("chunkSize", game.chunkSize);
             game.viewDistance = g.value("viewDistance", game.viewDistance);
             game.terrainScale = g.value("terrainScale", game.terrainScale);
+            game.chunkCacheEnabled = g.value("chunkCacheEnabled", game.chunkCacheEnabled);
+            game.chunkCacheDirectory = g.value("chunkCacheDirectory", game.chunkCacheDirectory);
+            game.terrainEditDirectory = g.value("terrainEditDirectory", game.terrainEditDirectory);
+            game.terrainMemoryBudgetMB = g.value("terrainMemoryBudgetMB", game.terrainMemoryBudgetMB);
+            game.fastBoot = g.value("fastBoot", game.fastBoot);
+            game.startupTimelinePath = g.value("startupTimelinePath", game.startupTimelinePath);
+            game.inputRecordPath = g.value("inputRecordPath", game.inputRecordPath);
+            game.inputReplayPath = g.value("inputReplayPath", game.inputReplayPath);
+            game.replayReportPath = g.value("replayReportPath", game.replayReportPath);
         }
     }
     catch (const std::exception& e) {
@@ -82,14 +92,24 @@ void Config::saveToFile(const std::string& filename) const {
             {"shadowMapSize", graphics.shadowMapSize},
             {"renderDistance", graphics.renderDistance},
             {"enableVsync", graphics.enableVsync},
-            {"maxFPS", graphics.maxFPS}
+            {"maxFPS", graphics.maxFPS},
+            {"shaderCacheDirectory", graphics.shaderCacheDirectory}
         };
 
         // Game config
         j["game"] = {
             {"chunkSize", game.chunkSize},
             {"viewDistance", game.viewDistance},
-            {"terrainScale", game.terrainScale}
+            {"terrainScale", game.terrainScale},
+            {"chunkCacheEnabled", game.chunkCacheEnabled},
+            {"chunkCacheDirectory", game.chunkCacheDirectory},
+            {"terrainEditDirectory", game.terrainEditDirectory},
+            {"terrainMemoryBudgetMB", game.terrainMemoryBudgetMB},
+            {"fastBoot", game.fastBoot},
+            {"startupTimelinePath", game.startupTimelinePath},
+            {"inputRecordPath", game.inputRecordPath},
+            {"inputReplayPath", game.inputReplayPath},
+            {"replayReportPath", game.replayReportPath}
         };
 
         std::ofstream file(filename);
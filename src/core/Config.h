@@ -21,12 +21,22 @@ struct GraphicsConfig {
     float renderDistance = 1000.0f;
     bool enableVsync = true;
     int maxFPS = 144;
+    std::string shaderCacheDirectory = "cache/shaders";  // Linked program binaries; empty disables
 };
 
 struct GameConfig {
     int chunkSize = 16;
     int viewDistance = 8;
     float terrainScale = 1.0f;
+    bool chunkCacheEnabled = true;
+    std::string chunkCacheDirectory = "cache/terrain";
+    std::string terrainEditDirectory = "saves/terrain";  // Empty disables persistent edits
+    int terrainMemoryBudgetMB = 64;  // Resident chunk CPU + GPU bytes before LRU eviction
+    bool fastBoot = false;  // Defer grass, arm, sky and debug renderers until after the first frame
+    std::string startupTimelinePath;  // Chrome trace of startup phases; empty disables the export
+    std::string inputRecordPath;   // Saves every simulation step's input here on exit; empty disables recording
+    std::string inputReplayPath;   // Plays a saved recording back one step per frame, then exits
+    std::string replayReportPath;  // JSON frame-time and streaming metrics of a replay; empty disables the export
 };
 
 class Config {
@@ -49,6 +59,7 @@ public:
         if (key == "graphics.maxFPS") return graphics.maxFPS;
         if (key == "game.chunkSize") return game.chunkSize;
         if (key == "game.viewDistance") return game.viewDistance;
+        if (key == "game.terrainMemoryBudgetMB") return game.terrainMemoryBudgetMB;
         return 0; // Default value
     }
 
@@ -1,8 +1,6 @@
 #include "Debug.h"
 #include <glad/glad.h>
-#include <iostream>
-#include <chrono>
-#include <ctime>
+#include "AsyncLogger.h"
 
 namespace Debug {
     bool wireframeEnabled = false;
@@ -57,26 +55,36 @@ namespace Debug {
         return showChunkBoundaries;
     }
 
-    // Helper function to get current timestamp
-    std::string getCurrentTimestamp() {
-        auto now = std::chrono::system_clock::now();
-        auto time = std::chrono::system_clock::to_time_t(now);
-        char buffer[26];
-        ctime_s(buffer, sizeof(buffer), &time);
-        std::string timestamp(buffer);
-        timestamp = timestamp.substr(0, timestamp.length() - 1); // Remove newline
-        return timestamp;
+    namespace {
+        void submit(AsyncLogger::Level level, const std::string& message) {
+            static AsyncLogger& logger = AsyncLogger::getInstance();  // First use starts the writer
+            if (AsyncLogger::isRunning() && (logger.push(level, message) || level != AsyncLogger::Level::Error)) {
+                return;
+            }
+            // Logger already torn down, or an error hit a full queue: never lose those
+            AsyncLogger::write(level, AsyncLogger::nowUs(), message);
+        }
+    }
+
+    void logVerbose(const std::string& message) {
+        if (LOG_MIN_LEVEL <= 0) submit(AsyncLogger::Level::Verbose, message);
     }
 
     void log(const std::string& message) {
-        std::cout << "[" << getCurrentTimestamp() << "] INFO: " << message << std::endl;
+        if (LOG_MIN_LEVEL <= 1) submit(AsyncLogger::Level::Info, message);
     }
 
     void logWarning(const std::string& message) {
-        std::cout << "[" << getCurrentTimestamp() << "] WARNING: " << message << std::endl;
+        if (LOG_MIN_LEVEL <= 2) submit(AsyncLogger::Level::Warning, message);
     }
 
     void logError(const std::string& message) {
-        std::cerr << "[" << getCurrentTimestamp() << "] ERROR: " << message << std::endl;
+        submit(AsyncLogger::Level::Error, message);
+    }
+
+    void flushLog() {
+        if (AsyncLogger::isRunning()) {
+            AsyncLogger::getInstance().flush();
+        }
     }
 } 
\ No newline at end of file
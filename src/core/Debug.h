@@ -3,6 +3,18 @@
 
 #include <string>
 
+// Lowest level compiled in: 0 = verbose, 1 = info, 2 = warning, 3 = error
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 1
+#endif
+
+// Per-frame or per-chunk chatter; compiles to nothing (message not even built) above level 0
+#if LOG_MIN_LEVEL <= 0
+#define DEBUG_LOG_VERBOSE(message) Debug::logVerbose(message)
+#else
+#define DEBUG_LOG_VERBOSE(message) ((void)0)
+#endif
+
 namespace Debug {
     // Debug state
     extern bool wireframeEnabled;
@@ -28,10 +40,13 @@ namespace Debug {
     void toggleChunkBoundaries();
     bool isChunkBoundariesEnabled();
 
-    // Debug logging
+    // Debug logging: queued to a background writer, never blocks the caller
+    void logVerbose(const std::string& message);
     void log(const std::string& message);
     void logWarning(const std::string& message);
     void logError(const std::string& message);
+    // Waits until queued messages are written (shutdown, crash handlers, tests)
+    void flushLog();
 }
 
 #endif
\ No newline at end of file
@@ -1,10 +1,7 @@
-#pragma once
-#include "IChunkFactory.h"
+#include "DefaultChunkFactory.h"
 #include "Chunk.h"
 
-class DefaultChunkFactory : public IChunkFactory {
-public:
-    std::shared_ptr<Chunk> createChunk(int x, int z, std::shared_ptr<Terrain> terrain) override {
-        return std::make_shared<Chunk>(x, z, terrain);
-    }
-};
+std::shared_ptr<Chunk> DefaultChunkFactory::createChunk(int x, int z, const std::shared_ptr<Terrain>& terrain) {
+    // Generation and upload are the caller's (normally the thread pool's) job
+    return pool.acquire(x, z, terrain, true);
+}
@@ -1,12 +1,17 @@
 #pragma once
 #include "IChunkFactory.h"
-#include "Chunk.h"
+#include "ChunkPool.h"
 
 class Terrain;
 
+// Recycles unloaded chunks through a ChunkPool; main thread only
 class DefaultChunkFactory : public IChunkFactory {
 public:
-    std::shared_ptr<Chunk> createChunk(int x, int z, std::shared_ptr<Terrain> terrain) override {
-        return std::make_shared<Chunk>(x, z, terrain);
-    }
+    std::shared_ptr<Chunk> createChunk(int x, int z, const std::shared_ptr<Terrain>& terrain) override;
+    void releaseChunk(const std::shared_ptr<Chunk>& chunk) override { pool.release(chunk); }
+
+    const ChunkPool& getPool() const { return pool; }
+
+private:
+    ChunkPool pool;
 };
@@ -0,0 +1,72 @@
+#include "GpuTimer.h"
+#include "Debug.h"
+#include "Profiler.h"
+
+GpuTimer::~GpuTimer() {
+    if (!supported) return;
+    for (auto& slot : slots) {
+        if (!slot.queries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+        }
+    }
+}
+
+void GpuTimer::initialize() {
+    // Timer queries are core since 3.3; a counter width of zero means the driver only stubs them
+    supported = GLVersion.major > 3 || (GLVersion.major == 3 && GLVersion.minor >= 3);
+    if (supported) {
+        GLint counterBits = 0;
+        glGetQueryiv(GL_TIME_ELAPSED, GL_QUERY_COUNTER_BITS, &counterBits);
+        supported = glGetError() == GL_NO_ERROR && counterBits > 0;
+    }
+
+    Debug::log(std::string("[GpuTimer] Timer queries ") + (supported ? "enabled" : "unavailable; GPU pass timings disabled"));
+}
+
+void GpuTimer::beginFrame() {
+    if (!supported) return;
+
+    frameIndex = (frameIndex + 1) % LATENCY;
+    collect(slots[frameIndex]);
+}
+
+void GpuTimer::collect(FrameSlot& slot) {
+    for (size_t i = 0; i < slot.names.size(); ++i) {
+        GLuint available = 0;
+        glGetQueryObjectuiv(slot.queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;  // Dropped rather than stalling; the next frames will report
+
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(slot.queries[i], GL_QUERY_RESULT, &elapsedNs);
+        Profiler::getInstance().recordValue(slot.names[i], static_cast<double>(elapsedNs) * 1e-6);
+    }
+    slot.names.clear();
+}
+
+void GpuTimer::begin(const char* name) {
+    if (!supported) return;
+    if (active) {
+        ++skippedBegins;
+        return;
+    }
+
+    FrameSlot& slot = slots[frameIndex];
+    if (slot.names.size() == slot.queries.size()) {
+        GLuint query = 0;
+        glGenQueries(1, &query);
+        slot.queries.push_back(query);
+    }
+    glBeginQuery(GL_TIME_ELAPSED, slot.queries[slot.names.size()]);
+    slot.names.push_back(name);
+    active = true;
+}
+
+void GpuTimer::end() {
+    if (skippedBegins > 0) {
+        --skippedBegins;
+        return;
+    }
+    if (!active) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    active = false;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <glad/glad.h>
+#include <vector>
+
+// GL_TIME_ELAPSED query pool for per-pass GPU timings.
+//
+// Queries issued in frame N are read back LATENCY frames later, and only when
+// GL_QUERY_RESULT_AVAILABLE says so, so the CPU never waits on the GPU. Results
+// are reported to the Profiler under the pass name, next to the CPU scopes.
+// Without timer query support (pre-3.3 context or a software stand-in with a
+// zero-bit counter) every call is a no-op.
+class GpuTimer {
+public:
+    static constexpr size_t LATENCY = 3;  // Frames in flight before a slot is reused
+
+    GpuTimer() = default;
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    // Requires a current GL context
+    void initialize();
+    bool isSupported() const { return supported; }
+
+    // Collects whatever finished LATENCY frames ago and starts a new slot
+    void beginFrame();
+
+    // Passes must not nest: GL allows one active GL_TIME_ELAPSED query at a time
+    void begin(const char* name);
+    void end();
+
+    class Scope {
+    public:
+        Scope(GpuTimer& timer, const char* name) : timer(timer) { timer.begin(name); }
+        ~Scope() { timer.end(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        GpuTimer& timer;
+    };
+
+private:
+    struct FrameSlot {
+        std::vector<GLuint> queries;       // Grows to the number of passes, then reused
+        std::vector<const char*> names;    // Pass for each issued query this frame
+    };
+
+    void collect(FrameSlot& slot);
+
+    std::array<FrameSlot, LATENCY> slots;
+    size_t frameIndex = 0;
+    bool supported = false;
+    bool active = false;
+    int skippedBegins = 0;  // Nested begin() calls that were ignored
+};
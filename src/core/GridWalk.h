@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <glm/glm.hpp>
+
+// 2D DDA (Amanatides & Woo) over a square grid in the xz plane.
+//
+// Visits, in order, every cell the segment origin + dir * t, t in [tMin, tMax]
+// crosses, passing the t range spent inside it. Stops as soon as visit returns
+// true. Cells are floor(x / cellSize), so callers with a bounded grid clamp the
+// indices they are given: a start exactly on a boundary can report a neighbour.
+template <typename Visit>
+bool walkGridXZ(const glm::vec3& origin, const glm::vec3& dir, float tMin, float tMax, float cellSize, Visit&& visit)
+{
+    constexpr float INF = std::numeric_limits<float>::infinity();
+    if (tMin > tMax) return false;
+
+    glm::vec3 start = origin + dir * tMin;
+    int cellX = static_cast<int>(std::floor(start.x / cellSize));
+    int cellZ = static_cast<int>(std::floor(start.z / cellSize));
+    int stepX = dir.x > 0.0f ? 1 : (dir.x < 0.0f ? -1 : 0);
+    int stepZ = dir.z > 0.0f ? 1 : (dir.z < 0.0f ? -1 : 0);
+
+    float tNextX = stepX == 0 ? INF : tMin + ((cellX + (stepX > 0)) * cellSize - start.x) / dir.x;
+    float tNextZ = stepZ == 0 ? INF : tMin + ((cellZ + (stepZ > 0)) * cellSize - start.z) / dir.z;
+    float tDeltaX = stepX == 0 ? INF : cellSize / std::fabs(dir.x);
+    float tDeltaZ = stepZ == 0 ? INF : cellSize / std::fabs(dir.z);
+
+    float t = tMin;
+    while (true) {
+        float tExit = std::min({tNextX, tNextZ, tMax});
+        if (visit(cellX, cellZ, t, tExit)) return true;
+        if (tExit >= tMax) return false;
+
+        if (tNextX < tNextZ) {
+            cellX += stepX;
+            t = tNextX;
+            tNextX += tDeltaX;
+        } else {
+            cellZ += stepZ;
+            t = tNextZ;
+            tNextZ += tDeltaZ;
+        }
+    }
+}
+
+// Clips [tMin, tMax] to the segment's overlap with the xz rectangle [minXZ, maxXZ]; false if none
+inline bool clipToRectXZ(const glm::vec3& origin, const glm::vec3& dir, const glm::vec2& minXZ, const glm::vec2& maxXZ,
+                         float& tMin, float& tMax)
+{
+    const float o[2] = {origin.x, origin.z};
+    const float d[2] = {dir.x, dir.z};
+    for (int axis = 0; axis < 2; ++axis) {
+        if (d[axis] == 0.0f) {
+            if (o[axis] < minXZ[axis] || o[axis] > maxXZ[axis]) return false;
+            continue;
+        }
+        float t0 = (minXZ[axis] - o[axis]) / d[axis];
+        float t1 = (maxXZ[axis] - o[axis]) / d[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+    }
+    return tMin <= tMax;
+}
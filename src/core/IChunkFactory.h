@@ -7,5 +7,8 @@ class Terrain;
 class IChunkFactory {
 public:
     virtual ~IChunkFactory() = default;
-    virtual std::shared_ptr<Chunk> createChunk(int x, int z, std::shared_ptr<Terrain> terrain) = 0;
+    // Terrain is passed by reference: chunks don't keep it alive, so no refcount traffic per chunk
+    virtual std::shared_ptr<Chunk> createChunk(int x, int z, const std::shared_ptr<Terrain>& terrain) = 0;
+    // Main thread: the chunk left residency, so a pooling factory may hand it out again
+    virtual void releaseChunk(const std::shared_ptr<Chunk>& chunk) {}
 };
@@ -5,9 +5,11 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include "Debug.h"
+#include "Profiler.h"
 #include "WindowManager.h"
 #include "Renderer.h"
 #include "Application.h"
+#include "Simulation.h"
 
 // Define all static members
 Camera* InputManager::camera = nullptr;
@@ -29,6 +31,7 @@ static bool f2Pressed = false;
 static bool f3Pressed = false;
 static bool f4Pressed = false;
 static bool f5Pressed = false;
+static bool f6Pressed = false;
 static bool spacePressed = false;
 static bool shiftSpacePressed = false;
 static bool punchPressed = false;
@@ -122,53 +125,53 @@ void InputManager::mouseCallback(GLFWwindow* window, double xpos, double ypos)
     }
 }
 
-void InputManager::processKeyboard(GLFWwindow* window, Player& player)
+void InputManager::sampleInput(GLFWwindow* window, SimInput& input)
 {
-    // Don't process movement if camera is disabled
-    if (cameraState == CameraState::Disabled) return;
-
-    const float currentSpeed = moveSpeed * (1.0f / 60.0f); // Normalize for 60 FPS
-
-    // Basic movement (allowed in Free and Locked states)
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-        player.moveForward(currentSpeed);
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-        player.moveBackward(currentSpeed);
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-        player.moveLeft(currentSpeed);
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-        player.moveRight(currentSpeed);
-
-    // Jump and Fly controls
+    input.yaw = yaw;
+    input.pitch = pitch;
+    input.lookFree = cameraState == CameraState::Free;
+    input.moveSpeed = moveSpeed;
+
+    double cursorX = 0.0, cursorY = 0.0;
+    glfwGetCursorPos(window, &cursorX, &cursorY);
+    input.cursorY = static_cast<float>(cursorY);
+    bool leftDown = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
+    bool rightDown = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS;
+    input.slingshotHeld = leftDown && rightDown;
+    input.liftHeld = rightDown;
+
+    // Movement is held off while the camera is disabled (e.g. slingshot charging)
+    bool canMove = cameraState != CameraState::Disabled;
     bool shiftHeld = glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS;
-
-    if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS)
+    bool spaceHeld = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
+    input.forward = canMove && glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS;
+    input.backward = canMove && glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS;
+    input.left = canMove && glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS;
+    input.right = canMove && glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS;
+    input.flyDown = canMove && shiftHeld;
+    input.flyUp = canMove && spaceHeld;
+
+    // Jump and Fly controls: edges stay set until a simulation step consumes them
+    if (canMove && spaceHeld)
     {
         if (shiftHeld && !shiftSpacePressed)
         {
-            player.toggleFlyMode();
+            input.toggleFly = true;
             shiftSpacePressed = true;
         }
         else if (!shiftHeld && !spacePressed)
         {
-            player.jump();
+            input.jump = true;
             spacePressed = true;
         }
     }
-    if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_RELEASE)
+    if (!spaceHeld)
     {
         spacePressed = false;
         shiftSpacePressed = false;
     }
 
-    // Vertical movement in fly mode
-    if (player.isInFlyMode())
-    {
-        if (shiftHeld)
-            player.moveDown(currentSpeed);
-        if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS)
-            player.moveUp(currentSpeed);
-    }
+    if (!canMove) return;
 
     // Action controls
     if (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS && !punchPressed)
@@ -297,6 +300,19 @@ void InputManager::handleDebugKeys(GLFWwindow *window)
     }
     if (glfwGetKey(window, GLFW_KEY_F5) == GLFW_RELEASE)
         f5Pressed = false;
+
+    // F6: Start/stop a Chrome trace capture (open the file in Perfetto)
+    if (glfwGetKey(window, GLFW_KEY_F6) == GLFW_PRESS && !f6Pressed)
+    {
+        Profiler& profiler = Profiler::getInstance();
+        if (profiler.isTracing())
+            profiler.stopTrace("profile_trace.json");
+        else
+            profiler.startTrace();
+        f6Pressed = true;
+    }
+    if (glfwGetKey(window, GLFW_KEY_F6) == GLFW_RELEASE)
+        f6Pressed = false;
 }
 
 bool InputManager::isKeyPressed(int key)
@@ -3,10 +3,11 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include "Camera.h"
-#include "Player.h"
 #include "IArmRenderer.h"
 #include <glm/glm.hpp>
 
+struct SimInput;
+
 // Similar to Swift's enum
 enum class CameraState {
     Free,       // Normal camera movement
@@ -20,7 +21,8 @@ public:
     static void keyCallback(GLFWwindow *window, int key, int scancode, int action, int mods);
     static void mouseCallback(GLFWwindow *window, double xpos, double ypos);
     static void scrollCallback(GLFWwindow* window, double xoffset, double yoffset);
-    static void processKeyboard(GLFWwindow *window, Player &player);
+    // Main thread, once per frame: held keys overwrite, edges (jump, fly toggle) accumulate
+    static void sampleInput(GLFWwindow *window, SimInput &input);
     static void setCamera(Camera *cam);
     static void setArmRenderer(IArmRenderer *arm) { armRenderer = arm; }
     static void handleDebugKeys(GLFWwindow* window);
@@ -0,0 +1,168 @@
+#include "InputRecording.h"
+#include <cstring>
+#include <fstream>
+#include "Debug.h"
+#include "WorldConstants.h"
+
+namespace {
+    constexpr char RECORDING_MAGIC[4] = {'I', 'N', 'P', 'T'};
+    constexpr uint32_t RECORDING_VERSION = 1;
+
+    // On-disk step; flags pack the SimInput booleans in declaration order
+    struct StepRecord {
+        float yaw;
+        float pitch;
+        float moveSpeed;
+        float cursorY;
+        uint32_t flags;
+        uint32_t reserved;
+        uint64_t checksum;
+    };
+    static_assert(sizeof(StepRecord) == 32, "StepRecord layout is part of the file format");
+
+    struct FileHeader {
+        char magic[4];
+        uint32_t version;
+        int32_t seed;
+        uint32_t stepCount;
+        float spawn[3];
+        uint32_t reserved;
+    };
+    static_assert(sizeof(FileHeader) == 32, "FileHeader layout is part of the file format");
+
+    enum StepFlag : uint32_t {
+        LOOK_FREE = 1u << 0,
+        FORWARD = 1u << 1,
+        BACKWARD = 1u << 2,
+        LEFT = 1u << 3,
+        RIGHT = 1u << 4,
+        FLY_UP = 1u << 5,
+        FLY_DOWN = 1u << 6,
+        JUMP = 1u << 7,
+        TOGGLE_FLY = 1u << 8,
+        SLINGSHOT_HELD = 1u << 9,
+        LIFT_HELD = 1u << 10,
+    };
+
+    uint32_t packFlags(const SimInput& input) {
+        uint32_t flags = 0;
+        if (input.lookFree) flags |= LOOK_FREE;
+        if (input.forward) flags |= FORWARD;
+        if (input.backward) flags |= BACKWARD;
+        if (input.left) flags |= LEFT;
+        if (input.right) flags |= RIGHT;
+        if (input.flyUp) flags |= FLY_UP;
+        if (input.flyDown) flags |= FLY_DOWN;
+        if (input.jump) flags |= JUMP;
+        if (input.toggleFly) flags |= TOGGLE_FLY;
+        if (input.slingshotHeld) flags |= SLINGSHOT_HELD;
+        if (input.liftHeld) flags |= LIFT_HELD;
+        return flags;
+    }
+
+    void unpackFlags(uint32_t flags, SimInput& input) {
+        input.lookFree = flags & LOOK_FREE;
+        input.forward = flags & FORWARD;
+        input.backward = flags & BACKWARD;
+        input.left = flags & LEFT;
+        input.right = flags & RIGHT;
+        input.flyUp = flags & FLY_UP;
+        input.flyDown = flags & FLY_DOWN;
+        input.jump = flags & JUMP;
+        input.toggleFly = flags & TOGGLE_FLY;
+        input.slingshotHeld = flags & SLINGSHOT_HELD;
+        input.liftHeld = flags & LIFT_HELD;
+    }
+}
+
+void InputRecording::begin(const glm::vec3& spawn) {
+    spawnPosition = spawn;
+    steps.clear();
+}
+
+void InputRecording::append(const SimInput& input, uint64_t checksumAfter) {
+    steps.push_back({input, checksumAfter});
+}
+
+bool InputRecording::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        Debug::logError("[InputRecording] Unable to write " + path);
+        return false;
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, RECORDING_MAGIC, 4);
+    header.version = RECORDING_VERSION;
+    header.seed = WorldConstants::SEED;
+    header.stepCount = static_cast<uint32_t>(steps.size());
+    header.spawn[0] = spawnPosition.x;
+    header.spawn[1] = spawnPosition.y;
+    header.spawn[2] = spawnPosition.z;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<StepRecord> records(steps.size());
+    for (size_t i = 0; i < steps.size(); ++i) {
+        const SimInput& input = steps[i].input;
+        records[i] = {input.yaw, input.pitch, input.moveSpeed, input.cursorY, packFlags(input), 0, steps[i].checksum};
+    }
+    out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(StepRecord));
+
+    if (!out) {
+        Debug::logError("[InputRecording] Failed writing " + path);
+        return false;
+    }
+    Debug::log("[InputRecording] Saved " + std::to_string(steps.size()) + " steps to " + path);
+    return true;
+}
+
+bool InputRecording::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        Debug::logError("[InputRecording] Unable to open " + path);
+        return false;
+    }
+
+    const auto fileSize = static_cast<uint64_t>(in.tellg());
+    in.seekg(0);
+
+    FileHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, RECORDING_MAGIC, 4) != 0 || header.version != RECORDING_VERSION) {
+        Debug::logError("[InputRecording] " + path + " is not an input recording");
+        return false;
+    }
+    if (header.seed != WorldConstants::SEED) {
+        Debug::logError("[InputRecording] " + path + " was recorded with world seed " + std::to_string(header.seed));
+        return false;
+    }
+
+    // A corrupt count must not turn into a huge allocation
+    if (header.stepCount > (fileSize - sizeof(FileHeader)) / sizeof(StepRecord)) {
+        Debug::logError("[InputRecording] " + path + " is truncated");
+        return false;
+    }
+
+    std::vector<StepRecord> records(header.stepCount);
+    in.read(reinterpret_cast<char*>(records.data()), records.size() * sizeof(StepRecord));
+    if (!in) {
+        Debug::logError("[InputRecording] " + path + " is truncated");
+        return false;
+    }
+
+    spawnPosition = glm::vec3(header.spawn[0], header.spawn[1], header.spawn[2]);
+    steps.clear();
+    steps.reserve(records.size());
+    for (const StepRecord& record : records) {
+        Step step{};
+        step.input.yaw = record.yaw;
+        step.input.pitch = record.pitch;
+        step.input.moveSpeed = record.moveSpeed;
+        step.input.cursorY = record.cursorY;
+        unpackFlags(record.flags, step.input);
+        step.checksum = record.checksum;
+        steps.push_back(step);
+    }
+    Debug::log("[InputRecording] Loaded " + std::to_string(steps.size()) + " steps from " + path);
+    return true;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Simulation.h"
+
+// Per-step simulation input, saved so a session can be replayed exactly.
+//
+// Each step stores the SimInput it consumed (look direction included) and the
+// simulation checksum after it, so a replay can report the first step where
+// it stopped matching. Files are only valid for the world seed they were
+// recorded with; load() rejects anything else.
+class InputRecording {
+public:
+    // Starts a new recording at the simulation's spawn
+    void begin(const glm::vec3& spawnPosition);
+    void append(const SimInput& input, uint64_t checksumAfter);
+
+    size_t size() const { return steps.size(); }
+    bool empty() const { return steps.empty(); }
+    const SimInput& inputAt(size_t step) const { return steps[step].input; }
+    uint64_t checksumAt(size_t step) const { return steps[step].checksum; }
+    const glm::vec3& getSpawnPosition() const { return spawnPosition; }
+
+    bool save(const std::string& path) const;
+    // Replaces the current contents; logs and returns false on a missing or mismatched file
+    bool load(const std::string& path);
+
+private:
+    struct Step {
+        SimInput input;
+        uint64_t checksum;
+    };
+
+    glm::vec3 spawnPosition{0.0f};
+    std::vector<Step> steps;
+};
@@ -0,0 +1,77 @@
+#include "MemoryTracker.h"
+#include <iomanip>
+#include <sstream>
+
+MemoryTracker& MemoryTracker::getInstance() {
+    static MemoryTracker instance;
+    return instance;
+}
+
+const char* MemoryTracker::getCategoryName(MemoryCategory category) {
+    switch (category) {
+    case MemoryCategory::ChunkCpu: return "ChunkCpu";
+    case MemoryCategory::ChunkGpu: return "ChunkGpu";
+    case MemoryCategory::GrassCpu: return "GrassCpu";
+    case MemoryCategory::GrassGpu: return "GrassGpu";
+    case MemoryCategory::ModelCpu: return "ModelCpu";
+    case MemoryCategory::ModelGpu: return "ModelGpu";
+    default: return "Unknown";
+    }
+}
+
+void MemoryTracker::adjust(MemoryCategory category, int64_t deltaBytes, int64_t deltaObjects) {
+    Counters& c = counters[static_cast<size_t>(category)];
+    int64_t now = c.bytes.fetch_add(deltaBytes, std::memory_order_relaxed) + deltaBytes;
+    if (deltaObjects != 0) {
+        c.objects.fetch_add(deltaObjects, std::memory_order_relaxed);
+    }
+
+    int64_t peak = c.peakBytes.load(std::memory_order_relaxed);
+    while (now > peak && !c.peakBytes.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+}
+
+size_t MemoryTracker::getBytes(MemoryCategory category) const {
+    int64_t bytes = counters[static_cast<size_t>(category)].bytes.load(std::memory_order_relaxed);
+    return bytes > 0 ? static_cast<size_t>(bytes) : 0;
+}
+
+size_t MemoryTracker::getPeakBytes(MemoryCategory category) const {
+    return static_cast<size_t>(counters[static_cast<size_t>(category)].peakBytes.load(std::memory_order_relaxed));
+}
+
+size_t MemoryTracker::getObjectCount(MemoryCategory category) const {
+    int64_t objects = counters[static_cast<size_t>(category)].objects.load(std::memory_order_relaxed);
+    return objects > 0 ? static_cast<size_t>(objects) : 0;
+}
+
+size_t MemoryTracker::getTotalBytes() const {
+    size_t total = 0;
+    for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+        total += getBytes(static_cast<MemoryCategory>(i));
+    }
+    return total;
+}
+
+MemoryTracker::CategoryStats MemoryTracker::getStats(MemoryCategory category) const {
+    return {getCategoryName(category), getBytes(category), getPeakBytes(category), getObjectCount(category)};
+}
+
+std::string MemoryTracker::formatSummary() const {
+    constexpr double MB = 1024.0 * 1024.0;
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << "mem MB: total " << getTotalBytes() / MB;
+    for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+        CategoryStats stats = getStats(static_cast<MemoryCategory>(i));
+        out << " | " << stats.name << " " << stats.bytes / MB << " (" << stats.objects << ")";
+    }
+    return out.str();
+}
+
+void TrackedBytes::set(size_t newBytes) {
+    if (newBytes == bytes) return;
+    int64_t deltaObjects = (bytes == 0) - (newBytes == 0);
+    MemoryTracker::getInstance().adjust(category, static_cast<int64_t>(newBytes) - static_cast<int64_t>(bytes),
+                                        deltaObjects);
+    bytes = newBytes;
+}
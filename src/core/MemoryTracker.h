@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+enum class MemoryCategory : uint8_t {
+    ChunkCpu,   // Vertex/normal/index vectors kept for edits and raycasts
+    ChunkGpu,   // VBO + EBO per uploaded chunk
+    GrassCpu,
+    GrassGpu,   // Instance buffer
+    ModelCpu,   // glTF buffers/images and mesh vectors
+    ModelGpu,   // Mesh buffers and textures
+    Count
+};
+
+// Byte accounting for long-lived terrain and render resources.
+//
+// Owners report what they hold through a TrackedBytes member; totals, peaks and
+// live object counts per category are lock-free atomics so workers can report
+// from generate() without contention. ChunkManager derives its residency budget
+// from these numbers, and the debug overlay prints formatSummary().
+class MemoryTracker {
+public:
+    static constexpr size_t CATEGORY_COUNT = static_cast<size_t>(MemoryCategory::Count);
+
+    struct CategoryStats {
+        const char* name;
+        size_t bytes;
+        size_t peakBytes;
+        size_t objects;  // Owners currently holding a non-zero amount
+    };
+
+    static MemoryTracker& getInstance();
+    static const char* getCategoryName(MemoryCategory category);
+
+    void adjust(MemoryCategory category, int64_t deltaBytes, int64_t deltaObjects);
+
+    size_t getBytes(MemoryCategory category) const;
+    size_t getPeakBytes(MemoryCategory category) const;
+    size_t getObjectCount(MemoryCategory category) const;
+    size_t getTotalBytes() const;
+    CategoryStats getStats(MemoryCategory category) const;
+
+    // "mem MB: total 61.2 | ChunkCpu 25.1 (498) | ..."
+    std::string formatSummary() const;
+
+private:
+    struct Counters {
+        std::atomic<int64_t> bytes{0};
+        std::atomic<int64_t> peakBytes{0};
+        std::atomic<int64_t> objects{0};
+    };
+
+    MemoryTracker() = default;
+
+    std::array<Counters, CATEGORY_COUNT> counters;
+};
+
+// Reports one owner's current footprint in a category; the destructor releases it
+class TrackedBytes {
+public:
+    explicit TrackedBytes(MemoryCategory category) : category(category) {}
+    ~TrackedBytes() { set(0); }
+
+    TrackedBytes(const TrackedBytes&) = delete;
+    TrackedBytes& operator=(const TrackedBytes&) = delete;
+
+    // Not thread-safe per instance: call from whichever thread owns the resource
+    void set(size_t newBytes);
+    size_t get() const { return bytes; }
+
+private:
+    MemoryCategory category;
+    size_t bytes = 0;
+};
@@ -53,19 +53,19 @@ void Mesh::setupMesh()
 
 void Mesh::Draw(Shader &shader)
 {
-    Debug::log("Drawing mesh with " + std::to_string(vertices.size()) + " vertices and " + 
-               std::to_string(indices.size()) + " indices");
+    DEBUG_LOG_VERBOSE("Drawing mesh with " + std::to_string(vertices.size()) + " vertices and " +
+                      std::to_string(indices.size()) + " indices");
 
     if (textureId > 0)
     {
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, textureId);
         shader.setInt("texture_diffuse", 0);
-        Debug::log("Using texture ID: " + std::to_string(textureId));
+        DEBUG_LOG_VERBOSE("Using texture ID: " + std::to_string(textureId));
     }
     else
     {
-        Debug::log("No texture bound for this mesh");
+        DEBUG_LOG_VERBOSE("No texture bound for this mesh");
     }
 
     glBindVertexArray(VAO);
@@ -147,6 +147,26 @@ void Model::loadModel(const std::string &path)
     }
 
     Debug::log("Model processing complete. Created " + std::to_string(meshes.size()) + " meshes.");
+    reportMemory();
+}
+
+void Model::reportMemory()
+{
+    // The parsed glTF (buffers and decoded images) stays alive alongside the meshes
+    size_t cpu = 0;
+    for (const auto &buffer : gltf->buffers)
+        cpu += buffer.data.capacity();
+    for (const auto &image : gltf->images)
+        cpu += image.image.capacity();
+
+    size_t gpu = textureBytes;
+    for (const auto &mesh : meshes)
+    {
+        cpu += mesh->vertices.capacity() * sizeof(Vertex) + mesh->indices.capacity() * sizeof(uint32_t);
+        gpu += mesh->vertices.size() * sizeof(Vertex) + mesh->indices.size() * sizeof(uint32_t);
+    }
+    cpuBytes.set(cpu);
+    gpuBytes.set(gpu);
 }
 
 void Model::processNode(const tinygltf::Node &node, const tinygltf::Model &model)
@@ -346,6 +366,7 @@ uint32_t Model::loadTexture(const tinygltf::Model &model, int textureIndex)
 
     glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, image.image.data());
     glGenerateMipmap(GL_TEXTURE_2D);
+    textureBytes += static_cast<size_t>(image.width) * image.height * (image.component == 3 ? 3 : 4) * 4 / 3;  // + mips
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -6,6 +6,7 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include "core/Shader.h"
+#include "MemoryTracker.h"
 
 // Forward declarations
 namespace tinygltf {
@@ -45,7 +46,11 @@ public:
 private:
     std::vector<std::unique_ptr<Mesh>> meshes;
     std::unique_ptr<tinygltf::Model> gltf;
-    
+    size_t textureBytes = 0;
+    TrackedBytes cpuBytes{MemoryCategory::ModelCpu};
+    TrackedBytes gpuBytes{MemoryCategory::ModelGpu};
+
+    void reportMemory();
     void loadModel(const std::string& path);
     void processNode(const tinygltf::Node& node, const tinygltf::Model& model);
     std::unique_ptr<Mesh> processMesh(const tinygltf::Mesh& mesh, const tinygltf::Model& model);
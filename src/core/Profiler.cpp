@@ -0,0 +1,190 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include "Debug.h"
+
+namespace {
+    constexpr size_t MAX_TRACE_EVENTS = 2'000'000;  // ~50 MB of JSON; capture stops growing past this
+
+    static_assert((Profiler::RING_CAPACITY & (Profiler::RING_CAPACITY - 1)) == 0,
+                  "RING_CAPACITY must be a power of two");
+
+    double percentile(std::vector<double>& values, double fraction) {
+        if (values.empty()) return 0.0;
+        size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * (values.size() - 1) + 0.5));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    void writeJsonString(std::ostream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') out << '\\';
+            out << *c;
+        }
+        out << '"';
+    }
+}
+
+Profiler& Profiler::getInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() = default;
+
+Profiler::ThreadRing& Profiler::localRing() {
+    thread_local ThreadRing* ring = nullptr;
+    if (!ring) {
+        auto owned = std::make_unique<ThreadRing>();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        owned->threadIndex = static_cast<uint32_t>(rings.size());
+        ring = owned.get();
+        rings.push_back(std::move(owned));
+    }
+    return *ring;
+}
+
+void Profiler::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadRing& ring = localRing();
+    size_t head = ring.head.load(std::memory_order_relaxed);
+    size_t tail = ring.tail.load(std::memory_order_acquire);
+    if (head - tail >= RING_CAPACITY) {
+        // Consumer is behind (no endFrame for a while); never block the caller
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring.events[head & (RING_CAPACITY - 1)] = {name, startNs, endNs};
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::recordValue(const char* name, double ms) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    pendingValues.emplace_back(name, ms);
+}
+
+void Profiler::endFrame() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    bool capture = tracing.load(std::memory_order_relaxed);
+
+    for (auto& [name, entry] : history) {
+        entry.lastMs = 0.0;
+        entry.callsLastFrame = 0;
+    }
+
+    for (auto& ring : rings) {
+        size_t tail = ring->tail.load(std::memory_order_relaxed);
+        size_t head = ring->head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            const Event& event = ring->events[tail & (RING_CAPACITY - 1)];
+            History& entry = history[event.name];
+            entry.lastMs += static_cast<double>(event.endNs - event.startNs) * 1e-6;
+            entry.callsLastFrame++;
+
+            if (capture && event.startNs >= traceOriginNs && traceEvents.size() < MAX_TRACE_EVENTS) {
+                traceEvents.push_back({event, ring->threadIndex});
+            }
+        }
+        ring->tail.store(head, std::memory_order_release);
+    }
+
+    for (const auto& [name, ms] : pendingValues) {
+        History& entry = history[name];
+        entry.lastMs += ms;
+        entry.callsLastFrame++;
+    }
+    pendingValues.clear();
+
+    // Frames where a scope did not run count as zero, so percentiles are per frame
+    for (auto& [name, entry] : history) {
+        entry.frameMs.push_back(entry.lastMs);
+        if (entry.frameMs.size() > HISTORY_FRAMES) {
+            entry.frameMs.pop_front();
+        }
+    }
+}
+
+std::vector<Profiler::ScopeStats> Profiler::getStats() const {
+    std::vector<ScopeStats> stats;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    stats.reserve(history.size());
+
+    std::vector<double> values;
+    for (const auto& [name, entry] : history) {
+        values.assign(entry.frameMs.begin(), entry.frameMs.end());
+        ScopeStats s;
+        s.name = std::string(name);
+        s.lastMs = entry.lastMs;
+        s.callsLastFrame = entry.callsLastFrame;
+        s.p50Ms = percentile(values, 0.50);
+        s.p95Ms = percentile(values, 0.95);
+        s.p99Ms = percentile(values, 0.99);
+        s.maxMs = values.empty() ? 0.0 : *std::max_element(values.begin(), values.end());
+        s.avgMs = values.empty() ? 0.0 : std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+        stats.push_back(std::move(s));
+    }
+
+    std::sort(stats.begin(), stats.end(), [](const ScopeStats& a, const ScopeStats& b) {
+        return a.p95Ms > b.p95Ms;
+    });
+    return stats;
+}
+
+std::string Profiler::formatSummary(size_t maxEntries) const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << "avg/p95/max ms:";
+    auto stats = getStats();
+    for (size_t i = 0; i < stats.size() && i < maxEntries; ++i) {
+        out << (i ? " | " : " ") << stats[i].name << " " << stats[i].avgMs << "/" << stats[i].p95Ms << "/"
+            << stats[i].maxMs;
+    }
+    return out.str();
+}
+
+void Profiler::startTrace() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    traceEvents.clear();
+    traceOriginNs = nowNs();
+    tracing.store(true, std::memory_order_relaxed);
+    Debug::log("[Profiler] Trace capture started");
+}
+
+bool Profiler::stopTrace(const std::string& path) {
+    std::vector<TraceEvent> captured;
+    uint64_t origin = 0;
+    size_t threadCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        tracing.store(false, std::memory_order_relaxed);
+        captured.swap(traceEvents);
+        origin = traceOriginNs;
+        threadCount = rings.size();
+    }
+
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        Debug::logError("[Profiler] Unable to write trace to " + path);
+        return false;
+    }
+
+    // Chrome trace-event format: complete ("X") events in microseconds
+    out << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (size_t i = 0; i < threadCount; ++i) {
+        out << (i ? "," : "") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+            << ",\"args\":{\"name\":\"thread " << i << "\"}}";
+    }
+    for (const TraceEvent& trace : captured) {
+        out << ",{\"name\":";
+        writeJsonString(out, trace.event.name);
+        out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << trace.threadIndex
+            << ",\"ts\":" << static_cast<double>(trace.event.startNs - origin) * 1e-3
+            << ",\"dur\":" << static_cast<double>(trace.event.endNs - trace.event.startNs) * 1e-3 << "}";
+    }
+    out << "]}\n";
+
+    Debug::log("[Profiler] Wrote " + std::to_string(captured.size()) + " events to " + path);
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Build with -DPROFILER_ENABLED=0 to compile every PROFILE_SCOPE out
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+// Scoped CPU timers.
+//
+// Each thread writes completed scopes into its own fixed-size ring buffer
+// (single producer, single consumer, no locks on the hot path). Once per frame
+// the main thread drains every ring in endFrame(), folds the durations into
+// per-name frame totals and keeps a rolling window for percentiles. While a
+// trace capture is running the raw events are also kept for Chrome trace-event
+// JSON export (open in Perfetto or chrome://tracing).
+class Profiler {
+public:
+    struct Event {
+        const char* name;  // Must outlive the profiler (string literals)
+        uint64_t startNs;
+        uint64_t endNs;
+    };
+
+    struct ScopeStats {
+        std::string name;
+        double lastMs = 0.0;   // Total time in the last completed frame
+        double avgMs = 0.0;    // Rolling average over the history window
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+        uint32_t callsLastFrame = 0;
+    };
+
+    static constexpr size_t RING_CAPACITY = 8192;  // Events per thread between drains (power of two)
+    static constexpr size_t HISTORY_FRAMES = 240;
+
+    static Profiler& getInstance();
+
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Hot path: called by ProfileScope on the owning thread
+    void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Adds an externally measured duration (e.g. GPU pass time) to the current frame
+    void recordValue(const char* name, double ms);
+
+    // Main thread, once per frame
+    void endFrame();
+
+    // Sorted by p95, slowest first
+    std::vector<ScopeStats> getStats() const;
+    std::string formatSummary(size_t maxEntries = 6) const;
+
+    void startTrace();
+    bool isTracing() const { return tracing.load(std::memory_order_relaxed); }
+    // Writes the captured events and stops capturing; false if the file could not be written
+    bool stopTrace(const std::string& path);
+
+    uint64_t getDroppedEvents() const { return droppedEvents.load(std::memory_order_relaxed); }
+
+private:
+    struct ThreadRing {
+        std::array<Event, RING_CAPACITY> events;
+        std::atomic<size_t> head{0};  // Next write (producer)
+        std::atomic<size_t> tail{0};  // Next read (consumer)
+        uint32_t threadIndex = 0;
+    };
+
+    struct TraceEvent {
+        Event event;
+        uint32_t threadIndex;
+    };
+
+    struct History {
+        std::deque<double> frameMs;
+        double lastMs = 0.0;
+        uint32_t callsLastFrame = 0;
+    };
+
+    Profiler();
+    ThreadRing& localRing();
+
+    mutable std::mutex registryMutex;  // Only taken when a thread registers or on drain/report
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+
+    std::unordered_map<std::string_view, History> history;  // Keyed by content: equal literals may differ in address
+    std::vector<std::pair<const char*, double>> pendingValues;
+    std::vector<TraceEvent> traceEvents;
+    std::atomic<bool> tracing{false};
+    std::atomic<uint64_t> droppedEvents{0};
+    uint64_t traceOriginNs = 0;
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name(name), startNs(Profiler::nowNs()) {}
+    ~ProfileScope() { Profiler::getInstance().record(name, startNs, Profiler::nowNs()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t startNs;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if PROFILER_ENABLED
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
@@ -4,24 +4,20 @@
 std::optional<glm::vec3> Raycaster::raycastToTerrain(
     const Camera& camera,
     std::shared_ptr<Terrain> terrain,
-    float maxDistance,
-    float step)
+    float maxDistance)
 {
     if (!terrain) return std::nullopt;
 
-    glm::vec3 rayOrigin = camera.getPosition();
-    glm::vec3 rayDirection = camera.getFront();
-    
-    for (float distance = 0.0f; distance < maxDistance; distance += step)
-    {
-        glm::vec3 currentPoint = rayOrigin + rayDirection * distance;
-        float terrainHeight = terrain->getHeightAt(currentPoint.x, currentPoint.z);
-        
-        if (currentPoint.y <= terrainHeight)
-        {
-            return currentPoint;
-        }
-    }
-    
-    return std::nullopt;
+    return terrain->raycast(camera.getPosition(), camera.getFront(), maxDistance);
+}
+
+void Raycaster::raycastBatch(
+    const std::shared_ptr<Terrain>& terrain,
+    const std::vector<Ray>& rays,
+    std::vector<Hit>& hits)
+{
+    hits.assign(rays.size(), Hit{});
+    if (!terrain) return;
+
+    terrain->raycastBatch(rays.data(), rays.size(), hits.data());
 }
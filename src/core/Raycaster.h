@@ -2,6 +2,7 @@
 
 #include <glm/glm.hpp>
 #include <optional>
+#include <vector>
 #include "Camera.h"
 #include "Terrain.h"
 
@@ -9,9 +10,19 @@ class Raycaster
 {
 public:
     // Performs a raycast from the center of the screen and returns a world-space hit point
+    // on the resident terrain mesh (see Terrain::raycast)
     static std::optional<glm::vec3> raycastToTerrain(
         const Camera &camera,
         std::shared_ptr<Terrain> terrain,
-        float maxDistance = 100.0f,
-        float step = 0.5f);
+        float maxDistance = 100.0f);
+
+    using Ray = Terrain::Ray;
+    using Hit = Terrain::RayHit;
+
+    // Casts many rays (projectiles, trajectory previews, line of sight) across the terrain
+    // thread pool; hits is resized to match rays
+    static void raycastBatch(
+        const std::shared_ptr<Terrain>& terrain,
+        const std::vector<Ray>& rays,
+        std::vector<Hit>& hits);
 };
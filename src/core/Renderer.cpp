@@ -7,7 +7,10 @@
 #include <vector>
 
 #include "Debug.h"
+#include "Profiler.h"
+#include "StartupTimeline.h"
 #include "Shader.h"
+#include "ShaderLibrary.h"
 #include "Camera.h"
 #include "InputManager.h"
 
@@ -19,6 +22,9 @@ Renderer::Renderer(Camera &camera)
 
 Renderer::~Renderer()
 {
+    if (terrain && grassRenderer) {
+        terrain->setChunkUnloadCallback(nullptr);
+    }
     cleanupOpenGLResources();
 }
 
@@ -29,19 +35,19 @@ void Renderer::cleanupOpenGLResources()
     if (EBO != 0) glDeleteBuffers(1, &EBO);
 }
 
-void Renderer::initialize(std::shared_ptr<Terrain> terrainPtr)
+void Renderer::initialize(std::shared_ptr<Terrain> terrainPtr, bool fastBoot)
 {
     try {
         terrain = terrainPtr;
         
         // Create and store shader
-        shader = std::make_unique<Shader>("shaders/terrain.vert", "shaders/terrain.frag");
-        shader->use(); // Use the shader once at initialization
-        shader->setVec3("lightDir", glm::normalize(glm::vec3(0.0f, 1.0f, 0.0f)));
-        shader->setVec3("baseColor", glm::vec3(0.4f, 0.8f, 0.4f)); // grassy color
-
-        // Initialize sky gradient first since it's our background
-        skyGradient = std::make_unique<SkyGradient>();
+        {
+            STARTUP_PHASE("renderer: terrain shader");
+            shader = std::make_unique<Shader>("shaders/terrain.vert", "shaders/terrain.frag");
+            shader->use(); // Use the shader once at initialization
+            shader->setVec3("lightDir", glm::normalize(glm::vec3(0.0f, 1.0f, 0.0f)));
+            shader->setVec3("baseColor", glm::vec3(0.4f, 0.8f, 0.4f)); // grassy color
+        }
 
         // Set up OpenGL state
         glEnable(GL_DEPTH_TEST);
@@ -54,27 +60,52 @@ void Renderer::initialize(std::shared_ptr<Terrain> terrainPtr)
         // Check for OpenGL errors
         checkGLError("initialize");
 
-        // Initialize other renderers
-        debugMarker = std::make_unique<DebugMarker>();
-        debugMarker->initialize();
-
-        terrainManipulator = std::make_unique<TerrainManipulator>();
-        terrainManipulator->initialize(terrain);
-
-        reticleRenderer = std::make_unique<ReticleRenderer>();
-        reticleRenderer->initialize();
-
-        grassSpawner = std::make_unique<GrassSpawner>(terrain, 2);
-        grassSpawner->generate();
-
-        grassRenderer = std::make_unique<GrassRenderer>();
-        grassRenderer->initialize();
-        grassRenderer->update(grassSpawner->getGrassPositions());
+        // Gameplay and UI renderers are always ready for the first frame
+        {
+            STARTUP_PHASE("renderer: globs + reticle");
+            globMesh = std::make_unique<EarthGlob>();
+            globMesh->initialize();
 
-        gridRenderer = std::make_unique<GridRenderer>(200, 1.0f);
-        
-        // Initialize with standard arm renderer
-        setArmRendererType(ArmRendererType::Standard);
+            reticleRenderer = std::make_unique<ReticleRenderer>();
+            reticleRenderer->initialize();
+        }
+        gpuTimer.initialize();
+
+        // Sky is our background; everything below is cosmetic and can arrive a few frames late.
+        // Each step yields until the driver has finished its submitted programs, so taking them never waits.
+        ShaderLibrary& library = ShaderLibrary::getInstance();
+        deferredSteps.push_back({"renderer: sky", [this, &library] {
+            if (!library.isReady("shaders/sky_gradient_vertex.glsl", "shaders/sky_gradient_fragment.glsl")) return false;
+            skyGradient = std::make_unique<SkyGradient>();
+            return true;
+        }});
+        deferredSteps.push_back({"renderer: arm", [this, &library] {
+            if (!library.isReady("shaders/arm.vert", "shaders/arm.frag")) return false;
+            setArmRendererType(ArmRendererType::Standard);
+            return true;
+        }});
+        deferredSteps.push_back({"renderer: debug renderers", [this, &library] {
+            if (!library.isReady("shaders/debug_marker.vert", "shaders/debug_marker.frag") ||
+                !library.isReady("shaders/grid_vertex.glsl", "shaders/grid_fragment.glsl")) {
+                return false;
+            }
+            debugMarker = std::make_unique<DebugMarker>();
+            debugMarker->initialize();
+            gridRenderer = std::make_unique<GridRenderer>(200, 1.0f);
+            return true;
+        }});
+        deferredSteps.push_back({"renderer: grass", [this, &library] {
+            if (!library.isReady("shaders/grass.vert", "shaders/grass.frag")) return false;
+            grassRenderer = std::make_unique<GrassRenderer>();
+            grassRenderer->initialize();
+            // Blades are placed per chunk by the workers; the renderer only tracks residency
+            terrain->setChunkUnloadCallback([this](Chunk& chunk) { grassRenderer->removeChunk(chunk); });
+            return true;
+        }});
+
+        if (!fastBoot) {
+            while (runDeferredStep()) {}
+        }
 
         initialized = true;
         Debug::log("Renderer initialized successfully");
@@ -84,20 +115,47 @@ void Renderer::initialize(std::shared_ptr<Terrain> terrainPtr)
     }
 }
 
+bool Renderer::runDeferredStep()
+{
+    if (deferredSteps.empty()) {
+        return false;
+    }
+
+    DeferredStep step = std::move(deferredSteps.front());
+    deferredSteps.pop_front();
+
+    double startMs = StartupTimeline::getInstance().nowMs();
+    if (step.run()) {
+        StartupTimeline::getInstance().record(step.name, startMs, StartupTimeline::getInstance().nowMs());
+    } else {
+        deferredSteps.push_back(std::move(step));  // Not ready; the rest of the queue goes first
+    }
+    return !deferredSteps.empty();
+}
+
 void Renderer::render()
 {
+    PROFILE_SCOPE("Renderer::render");
     if (!initialized) {
         Debug::logWarning("Attempting to render before initialization");
         return;
     }
 
+    gpuTimer.beginFrame();
+
     // Clear buffers
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
     // Render sky gradient (background)
-    glDisable(GL_DEPTH_TEST);
-    skyGradient->render();
-    glEnable(GL_DEPTH_TEST);
+    {
+        PROFILE_SCOPE("Render::sky");
+        GpuTimer::Scope gpuScope(gpuTimer, "GPU::sky");
+        if (skyGradient) {
+            glDisable(GL_DEPTH_TEST);
+            skyGradient->render();
+            glEnable(GL_DEPTH_TEST);
+        }
+    }
     
     // Get the current framebuffer size
     int width, height;
@@ -114,38 +172,59 @@ void Renderer::render()
     glm::mat4 view = camera.getViewMatrix();
 
     // Render terrain chunks
-    shader->use();
-    shader->setMat4("view", view);
-    shader->setMat4("projection", projection);
-
-    // Ensure proper depth testing state
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-    glDepthMask(GL_TRUE);
+    {
+        PROFILE_SCOPE("Render::terrain");
+        GpuTimer::Scope gpuScope(gpuTimer, "GPU::terrain");
+        shader->use();
+        shader->setMat4("view", view);
+        shader->setMat4("projection", projection);
 
-    // Render terrain chunks
-    for (const auto& pair : terrain->getChunks()) {
-        const std::shared_ptr<Chunk>& chunk = pair.second;
-        if (chunk && chunk->isUploaded()) {
-            chunk->render(*shader);
-        }
+        // Ensure proper depth testing state
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_LESS);
+        glDepthMask(GL_TRUE);
+
+        terrain->forEachLoadedChunk([this](const std::shared_ptr<Chunk>& chunk) {
+            if (chunk->isUploaded()) {
+                if (grassRenderer && chunk->getGrassSlot() < 0) {
+                    grassRenderer->addChunk(*chunk);
+                }
+                chunk->uploadPendingEdits();
+                if (grassRenderer) {
+                    grassRenderer->updateChunk(*chunk);
+                }
+                chunk->render(*shader);
+            }
+        });
     }
 
     // Render grass with proper depth testing
     if (grassRenderer) {
+        PROFILE_SCOPE("Render::grass");
+        GpuTimer::Scope gpuScope(gpuTimer, "GPU::grass");
         float time = static_cast<float>(glfwGetTime());
         grassRenderer->render(view, projection, time);
     }
 
     // Render arm with proper depth
-    armRenderer->render(camera, projection);
+    if (armRenderer) {
+        PROFILE_SCOPE("Render::arm");
+        GpuTimer::Scope gpuScope(gpuTimer, "GPU::arm");
+        armRenderer->render(camera, projection);
+    }
 
     // Render debug elements
-    if (terrainManipulator) {
-        terrainManipulator->render(view, projection);
-    }
-    if (debugMarker) {
-        debugMarker->render(view, projection);
+    {
+        PROFILE_SCOPE("Render::debug");
+        GpuTimer::Scope gpuScope(gpuTimer, "GPU::debug");
+        if (globMesh) {
+            for (const glm::vec3& position : globPositions) {
+                globMesh->render(position, view, projection);
+            }
+        }
+        if (debugMarker) {
+            debugMarker->render(view, projection);
+        }
     }
 
     // Render UI elements last
@@ -178,22 +257,6 @@ void Renderer::updateChunksAroundPosition(float x, float z)
     }
 }
 
-void Renderer::beginTerrainLift(const glm::vec3& position)
-{
-    if (terrainManipulator)
-    {
-        terrainManipulator->beginLift(position);
-    }
-}
-
-void Renderer::updateTerrainManipulator(float deltaTime)
-{
-    if (terrainManipulator)
-    {
-        terrainManipulator->update(deltaTime);
-    }
-}
-
 void Renderer::setDebugMarkerPosition(const glm::vec3& position)
 {
     if (debugMarker)
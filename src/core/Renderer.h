@@ -1,6 +1,9 @@
 #pragma once
 
+#include <deque>
+#include <functional>
 #include <memory>
+#include <type_traits>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
@@ -9,11 +12,11 @@
 #include "Terrain.h"
 #include "SkyGradient.h"
 #include "DebugMarker.h"
-#include "TerrainManipulator.h"
+#include "EarthGlob.h"
 #include "ReticleRenderer.h"
-#include "GrassSpawner.h"
 #include "GrassRenderer.h"
 #include "GridRenderer.h"
+#include "GpuTimer.h"
 #include "IArmRenderer.h"
 #include "ArmRenderer.h"
 #include "TriArmRenderer.h"
@@ -34,15 +37,18 @@ public:
     Renderer(const Renderer&) = delete;
     Renderer& operator=(const Renderer&) = delete;
 
-    // Core rendering
-    void initialize(std::shared_ptr<Terrain> terrainPtr);
+    // Core rendering. In fast boot only what the first frame needs is created here;
+    // sky, arm, grass and debug renderers follow through runDeferredStep().
+    void initialize(std::shared_ptr<Terrain> terrainPtr, bool fastBoot = false);
+    // Main thread, once per frame: runs one deferred initialization step; false once none remain
+    bool runDeferredStep();
     void render();
     void updateProjectionMatrix(float aspectRatio);
     
     // Terrain management
     void updateChunksAroundPosition(float x, float z);
-    void beginTerrainLift(const glm::vec3& position);
-    void updateTerrainManipulator(float deltaTime);
+    // Where to draw the lifted earth globs this frame (interpolated simulation state)
+    void setGlobPositions(std::vector<glm::vec3> positions) { globPositions = std::move(positions); }
     
     // Debug visualization
     void setDebugMarkerPosition(const glm::vec3& position);
@@ -55,6 +61,21 @@ public:
     IArmRenderer* getArmRenderer() { return armRenderer.get(); }
 
 private:
+    // A step returning false is not ready yet and is retried on a later frame
+    struct DeferredStep {
+        const char* name;
+        std::function<bool()> run;
+
+        template <typename Fn>
+        DeferredStep(const char* name, Fn fn) : name(name) {
+            if constexpr (std::is_void_v<decltype(fn())>) {
+                run = [fn = std::move(fn)]() mutable { fn(); return true; };
+            } else {
+                run = std::move(fn);
+            }
+        }
+    };
+
     void initializeOpenGLState();
     void cleanupOpenGLResources();
     void checkGLError(const char* operation);
@@ -70,12 +91,14 @@ private:
     std::shared_ptr<Terrain> terrain;
     std::unique_ptr<SkyGradient> skyGradient;
     std::unique_ptr<DebugMarker> debugMarker;
-    std::unique_ptr<TerrainManipulator> terrainManipulator;
+    std::unique_ptr<EarthGlob> globMesh;
+    std::vector<glm::vec3> globPositions;
     std::unique_ptr<ReticleRenderer> reticleRenderer;
-    std::unique_ptr<GrassSpawner> grassSpawner;
     std::unique_ptr<GrassRenderer> grassRenderer;
     std::unique_ptr<GridRenderer> gridRenderer;
     std::unique_ptr<IArmRenderer> armRenderer;
+    GpuTimer gpuTimer;  // Per-pass GPU timings, reported through the Profiler
+    std::deque<DeferredStep> deferredSteps;
 
     // Matrices
     glm::mat4 projectionMatrix;
@@ -0,0 +1,91 @@
+#include "ReplayMetrics.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include "Debug.h"
+
+namespace {
+    // Nearest-rank percentile of an ascending list
+    double percentile(const std::vector<double>& sorted, double fraction) {
+        if (sorted.empty()) return 0.0;
+        size_t rank = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(rank, sorted.size() - 1)];
+    }
+}
+
+void ReplayMetrics::addFrame(double ms, size_t pendingUploads) {
+    frameMs.push_back(ms);
+    summary.maxPendingUploads = std::max(summary.maxPendingUploads, pendingUploads);
+}
+
+void ReplayMetrics::markDivergence(uint64_t step) {
+    if (!summary.checksumsMatched) return;
+    summary.checksumsMatched = false;
+    summary.firstDivergentStep = static_cast<int64_t>(step);
+}
+
+void ReplayMetrics::finish(uint64_t steps, uint64_t chunksLoaded, uint64_t chunksUnloaded, uint64_t streamingUpdates,
+                           size_t residentChunkBytes) {
+    summary.steps = steps;
+    summary.chunksLoaded = chunksLoaded;
+    summary.chunksUnloaded = chunksUnloaded;
+    summary.streamingUpdates = streamingUpdates;
+    summary.residentChunkBytes = residentChunkBytes;
+
+    std::vector<double> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+    summary.frames = sorted.size();
+    summary.totalMs = 0.0;
+    summary.framesOver16Ms = 0;
+    summary.framesOver33Ms = 0;
+    for (double ms : sorted) {
+        summary.totalMs += ms;
+        summary.framesOver16Ms += ms > 1000.0 / 60.0;
+        summary.framesOver33Ms += ms > 1000.0 / 30.0;
+    }
+    summary.averageMs = sorted.empty() ? 0.0 : summary.totalMs / static_cast<double>(sorted.size());
+    summary.p50Ms = percentile(sorted, 0.50);
+    summary.p95Ms = percentile(sorted, 0.95);
+    summary.p99Ms = percentile(sorted, 0.99);
+    summary.maxMs = sorted.empty() ? 0.0 : sorted.back();
+}
+
+std::string ReplayMetrics::formatReport() const {
+    const Summary& s = summary;
+    char buffer[512];
+    std::snprintf(buffer, sizeof(buffer),
+                  "[Replay] %zu frames, %llu steps in %.1f ms\n"
+                  "  frame ms  avg %.2f  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f  (>16.7: %zu, >33.3: %zu)\n"
+                  "  streaming  %llu loaded, %llu unloaded over %llu updates, peak %zu pending uploads, %zu KB resident",
+                  s.frames, static_cast<unsigned long long>(s.steps), s.totalMs, s.averageMs, s.p50Ms, s.p95Ms, s.p99Ms,
+                  s.maxMs, s.framesOver16Ms, s.framesOver33Ms, static_cast<unsigned long long>(s.chunksLoaded),
+                  static_cast<unsigned long long>(s.chunksUnloaded), static_cast<unsigned long long>(s.streamingUpdates),
+                  s.maxPendingUploads, s.residentChunkBytes >> 10);
+    std::string report = buffer;
+    report += s.checksumsMatched ? "\n  simulation matched the recording"
+                                 : "\n  simulation diverged from the recording at step " + std::to_string(s.firstDivergentStep);
+    return report;
+}
+
+bool ReplayMetrics::exportJson(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        Debug::logError("[Replay] Unable to write metrics to " + path);
+        return false;
+    }
+
+    const Summary& s = summary;
+    out << std::fixed << std::setprecision(3) << "{\"frames\":" << s.frames << ",\"steps\":" << s.steps
+        << ",\"totalMs\":" << s.totalMs << ",\"frameMs\":{\"avg\":" << s.averageMs << ",\"p50\":" << s.p50Ms
+        << ",\"p95\":" << s.p95Ms << ",\"p99\":" << s.p99Ms << ",\"max\":" << s.maxMs << "}"
+        << ",\"framesOver16Ms\":" << s.framesOver16Ms << ",\"framesOver33Ms\":" << s.framesOver33Ms
+        << ",\"checksumsMatched\":" << (s.checksumsMatched ? "true" : "false")
+        << ",\"firstDivergentStep\":" << s.firstDivergentStep
+        << ",\"streaming\":{\"chunksLoaded\":" << s.chunksLoaded << ",\"chunksUnloaded\":" << s.chunksUnloaded
+        << ",\"updates\":" << s.streamingUpdates << ",\"maxPendingUploads\":" << s.maxPendingUploads
+        << ",\"residentChunkBytes\":" << s.residentChunkBytes << "}}\n";
+
+    Debug::log("[Replay] Wrote metrics to " + path);
+    return static_cast<bool>(out);
+}
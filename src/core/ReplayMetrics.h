@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Frame-time and chunk-streaming figures for one replay run.
+//
+// Application feeds it once per frame while a recording plays back; finish()
+// folds in the run-wide totals. The report and JSON are what a regression run
+// compares between builds, so the same recording on the same machine should
+// give numbers that only move when the code does.
+class ReplayMetrics {
+public:
+    struct Summary {
+        size_t frames = 0;
+        double totalMs = 0.0;
+        double averageMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+        size_t framesOver16Ms = 0;  // Missed 60 Hz
+        size_t framesOver33Ms = 0;  // Missed 30 Hz
+
+        uint64_t steps = 0;
+        bool checksumsMatched = true;
+        int64_t firstDivergentStep = -1;
+
+        uint64_t chunksLoaded = 0;
+        uint64_t chunksUnloaded = 0;
+        uint64_t streamingUpdates = 0;
+        size_t maxPendingUploads = 0;
+        size_t residentChunkBytes = 0;
+    };
+
+    void addFrame(double frameMs, size_t pendingUploads);
+    // Call once when a step's checksum differs from the recorded one
+    void markDivergence(uint64_t step);
+    void finish(uint64_t steps, uint64_t chunksLoaded, uint64_t chunksUnloaded, uint64_t streamingUpdates,
+                size_t residentChunkBytes);
+
+    const Summary& getSummary() const { return summary; }
+    std::string formatReport() const;
+    bool exportJson(const std::string& path) const;
+
+private:
+    std::vector<double> frameMs;
+    Summary summary;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// FIFO over a power-of-two ring of slots.
+//
+// Unlike std::queue (a deque underneath), pushing only allocates when the
+// queue grows past its largest size so far; popped slots are reset and reused.
+// Not thread-safe: callers hold their own lock.
+template <typename T>
+class RingQueue {
+public:
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    T& front() { return slots[head]; }
+
+    void push(T value) {
+        if (count == slots.size()) grow();
+        slots[(head + count) & (slots.size() - 1)] = std::move(value);
+        ++count;
+    }
+
+    void pop() {
+        slots[head] = T();  // Drops whatever the slot owned now, not when it is overwritten
+        head = (head + 1) & (slots.size() - 1);
+        --count;
+    }
+
+private:
+    void grow() {
+        std::vector<T> larger(std::max<size_t>(16, slots.size() * 2));
+        for (size_t i = 0; i < count; ++i) {
+            larger[i] = std::move(slots[(head + i) & (slots.size() - 1)]);
+        }
+        slots.swap(larger);
+        head = 0;
+    }
+
+    std::vector<T> slots;
+    size_t head = 0;
+    size_t count = 0;
+};
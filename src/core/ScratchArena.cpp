@@ -0,0 +1,65 @@
+#include "ScratchArena.h"
+#include <algorithm>
+#include <cstdint>
+
+std::atomic<bool> ScratchArena::arenasEnabled{true};
+
+ScratchArena& ScratchArena::forThread() {
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+void* ScratchArena::do_allocate(size_t bytes, size_t alignment) {
+    if (!isEnabled()) {
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    while (true) {
+        if (current < blocks.size()) {
+            Block& block = blocks[current];
+            uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+            size_t aligned = ((base + offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+            if (aligned + bytes <= block.size) {
+                offset = aligned + bytes;
+                highWater = std::max(highWater, usedBeforeCurrent + offset);
+                return block.data.get() + aligned;
+            }
+            // Doesn't fit: move on to the next retained block, or grow below
+            usedBeforeCurrent += block.size;
+            ++current;
+            offset = 0;
+            continue;
+        }
+        // Oversized requests get a block of their own, with room to align
+        size_t size = std::max(BLOCK_SIZE, bytes + alignment);
+        blocks.push_back({std::make_unique<std::byte[]>(size), size});
+        current = blocks.size() - 1;
+        offset = 0;
+    }
+}
+
+void ScratchArena::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    if (!isEnabled()) {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    // Arena memory is reclaimed by rewind()
+}
+
+void ScratchArena::rewind(Marker marker) {
+    if (marker.block > current || (marker.block == current && marker.offset >= offset)) return;
+
+    usedBeforeCurrent = 0;
+    for (size_t i = 0; i < marker.block && i < blocks.size(); ++i) {
+        usedBeforeCurrent += blocks[i].size;
+    }
+    current = marker.block;
+    offset = marker.offset;
+}
+
+size_t ScratchArena::getCapacity() const {
+    size_t capacity = 0;
+    for (const auto& block : blocks) {
+        capacity += block.size;
+    }
+    return capacity;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// Per-thread bump allocator for short-lived generation temporaries.
+//
+// Each thread owns one arena (forThread()). Allocation is a pointer bump
+// inside a retained block, deallocation is a no-op, and memory is reclaimed
+// in bulk by rewinding: a Scope rewinds to where it started, and
+// TerrainThreadPool resets its workers' arenas after every task. Blocks are
+// kept, so once warm a worker never touches the global heap for scratch data.
+// Use it through std::pmr containers (ScratchVector) and reserve exact sizes:
+// growth leaves the old buffer behind until the rewind.
+class ScratchArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t BLOCK_SIZE = 256 * 1024;
+
+    struct Marker {
+        size_t block = 0;
+        size_t offset = 0;
+    };
+
+    // Rewinds the arena to its state at construction; nests
+    class Scope {
+    public:
+        explicit Scope(ScratchArena& arena) : arena(arena), marker(arena.mark()) {}
+        ~Scope() { arena.rewind(marker); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ScratchArena& arena;
+        Marker marker;
+    };
+
+    static ScratchArena& forThread();
+
+    // Benchmark switch: when disabled, every arena forwards to new/delete.
+    // Only flip it while no scratch containers are alive.
+    static void setEnabled(bool enabled) { arenasEnabled.store(enabled, std::memory_order_relaxed); }
+    static bool isEnabled() { return arenasEnabled.load(std::memory_order_relaxed); }
+
+    ScratchArena() = default;
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    Marker mark() const { return {current, offset}; }
+    void rewind(Marker marker);
+    void reset() { rewind({}); }
+
+    size_t getCapacity() const;
+    size_t getHighWater() const { return highWater; }  // Most bytes in use at once
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    static std::atomic<bool> arenasEnabled;
+
+    std::vector<Block> blocks;
+    size_t current = 0;  // Block being bumped
+    size_t offset = 0;   // Next free byte in blocks[current]
+    size_t usedBeforeCurrent = 0;
+    size_t highWater = 0;
+};
+
+template <typename T>
+using ScratchVector = std::pmr::vector<T>;
@@ -2,8 +2,20 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include "ShaderCache.h"
+#include "ShaderLibrary.h"
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath) {
+Shader::Shader(const char* vertexPath, const char* fragmentPath)
+    : Shader(ShaderLibrary::getInstance().take(vertexPath, fragmentPath))
+{
+}
+
+Shader::Shader(PendingProgram pendingProgram)
+    : ID(pendingProgram.program), pending(pendingProgram)
+{
+}
+
+Shader::PendingProgram Shader::submit(const char* vertexPath, const char* fragmentPath) {
     std::string vertexCode;
     std::string fragmentCode;
     std::ifstream vShaderFile;
@@ -24,39 +36,78 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     } catch (std::ifstream::failure&) {
         std::cerr << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << std::endl;
     }
+
+    // Warm starts skip compile and link entirely
+    PendingProgram result;
+    ShaderCache& cache = ShaderCache::getInstance();
+    result.cacheKey = cache.makeKey(vertexCode, fragmentCode);
+    result.program = cache.load(result.cacheKey);
+    if (result.program != 0) {
+        return result;
+    }
+
+    // No status queries here: asking for one would make the driver finish this program
+    // before the caller can submit the next
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
 
-    GLuint vertex, fragment;
-    vertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex, 1, &vShaderCode, NULL);
-    glCompileShader(vertex);
-    checkCompileErrors(vertex, "VERTEX");
+    result.vertex = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(result.vertex, 1, &vShaderCode, NULL);
+    glCompileShader(result.vertex);
 
-    fragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment, 1, &fShaderCode, NULL);
-    glCompileShader(fragment);
-    checkCompileErrors(fragment, "FRAGMENT");
+    result.fragment = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(result.fragment, 1, &fShaderCode, NULL);
+    glCompileShader(result.fragment);
 
     // Shader Program
-    ID = glCreateProgram();
-    glAttachShader(ID, vertex);
-    glAttachShader(ID, fragment);
-    glLinkProgram(ID);
-    checkCompileErrors(ID, "PROGRAM");
- 
-    // Delete the shaders as they're linked into our program now and no longer necessary
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
+    result.program = glCreateProgram();
+    glAttachShader(result.program, result.vertex);
+    glAttachShader(result.program, result.fragment);
+    cache.prepareForLink(result.program);
+    glLinkProgram(result.program);
+    return result;
+}
+
+bool Shader::isReady(const PendingProgram& program)
+{
+    if (program.program == 0 || program.vertex == 0 || !ShaderLibrary::getInstance().hasParallelCompile()) {
+        return true;
+    }
+    GLint complete = GL_FALSE;
+    glGetProgramiv(program.program, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete == GL_TRUE;
+}
+
+void Shader::resolve()
+{
+    if (pending.program == 0) return;
+
+    if (pending.vertex != 0) {
+        checkCompileErrors(pending.vertex, "VERTEX");
+        checkCompileErrors(pending.fragment, "FRAGMENT");
+        if (checkCompileErrors(pending.program, "PROGRAM")) {
+            ShaderCache::getInstance().store(pending.cacheKey, pending.program);
+        }
+
+        // Delete the shaders as they're linked into our program now and no longer necessary
+        glDeleteShader(pending.vertex);
+        glDeleteShader(pending.fragment);
+    }
+    pending = PendingProgram{};
 }
 
 Shader::~Shader()
 {
+    if (pending.vertex != 0) {
+        glDeleteShader(pending.vertex);
+        glDeleteShader(pending.fragment);
+    }
     glDeleteProgram(ID);
 }
 
 void Shader::use()
 {
+    resolve();
     glUseProgram(ID);
     if (ID == 0)
     {
@@ -92,7 +143,7 @@ void Shader::setInt(const std::string &name, int value) const {
     glUniform1i(loc, value);
 }
 
-void Shader::checkCompileErrors(GLuint shader, std::string type)
+bool Shader::checkCompileErrors(GLuint shader, std::string type)
 {
     GLint success;
     GLchar infoLog[1024];
@@ -116,4 +167,5 @@ void Shader::checkCompileErrors(GLuint shader, std::string type)
                       << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
         }
     }
+    return success == GL_TRUE;
 }
\ No newline at end of file
@@ -1,14 +1,34 @@
 #ifndef SHADER_H
 #define SHADER_H
 
+#include <cstdint>
 #include <string>        // ✅ Standard library first
 #include <glad/glad.h>     // ✅ glad immediately after standard headers
 #include <glm/glm.hpp>   // ✅ Other external libraries after glad
 
 class Shader {
 public:
+    // A program whose compile and link were issued but whose status has not been checked yet
+    struct PendingProgram {
+        GLuint program = 0;
+        GLuint vertex = 0;    // 0 when the program came from the binary cache
+        GLuint fragment = 0;
+        uint64_t cacheKey = 0;
+    };
+
     unsigned int ID;
-    Shader(const char* vertexSource, const char* fragmentSource);
+    // Adopts the ShaderLibrary's in-flight program for these files when there is one
+    Shader(const char* vertexPath, const char* fragmentPath);
+    explicit Shader(PendingProgram pending);
+
+    // Issues compile and link (or a binary cache load) without waiting for the driver
+    static PendingProgram submit(const char* vertexPath, const char* fragmentPath);
+
+    // Non-blocking with KHR_parallel_shader_compile; without it a submitted program counts as ready
+    static bool isReady(const PendingProgram& program);
+    // Waits for the link, reports errors and stores the binary; use() calls it on first use
+    void resolve();
+
     void use();
     void setMat4(const std::string &name, const glm::mat4 &mat) const;
     void setVec3(const std::string &name, const glm::vec3 &value) const;
@@ -17,8 +37,13 @@ public:
     
     ~Shader();
 
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+
 private:
-    void checkCompileErrors(unsigned int shader, std::string type); // ✅ Useful for debugging
+    static bool checkCompileErrors(unsigned int shader, std::string type); // ✅ Useful for debugging; true on success
+
+    PendingProgram pending;  // Cleared by resolve()
 };
 
 #endif
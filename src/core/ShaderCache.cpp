@@ -0,0 +1,198 @@
+#include "ShaderCache.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "Debug.h"
+
+namespace {
+    constexpr uint32_t FILE_MAGIC = 0x42535047;  // "GPSB"
+    constexpr uint32_t FILE_VERSION = 1;
+
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t key;  // Repeated so a renamed or colliding file is caught
+        uint32_t format;
+        uint32_t length;
+    };
+
+    uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    uint64_t fnv1a(uint64_t hash, const std::string& text) {
+        // Length first so "ab"+"c" and "a"+"bc" differ
+        uint64_t length = text.size();
+        hash = fnv1a(hash, &length, sizeof(length));
+        return fnv1a(hash, text.data(), text.size());
+    }
+
+    std::string glString(GLenum name) {
+        const GLubyte* value = glGetString(name);
+        return value ? reinterpret_cast<const char*>(value) : "";
+    }
+}
+
+ShaderCache& ShaderCache::getInstance() {
+    static ShaderCache instance;
+    return instance;
+}
+
+void ShaderCache::initialize(const std::string& cacheDirectory) {
+    enabled = false;
+    if (cacheDirectory.empty()) return;
+
+    // Program binaries are core in 4.1 and otherwise need ARB_get_program_binary
+    bool supported = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 1) ||
+                     GLAD_GL_ARB_get_program_binary;
+    GLint formatCount = 0;
+    if (supported) {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    }
+    if (formatCount <= 0) {
+        Debug::log("[ShaderCache] Program binaries unavailable; compiling shaders from source");
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDirectory, ec);
+    if (ec) {
+        Debug::logError("[ShaderCache] Unable to create " + cacheDirectory + ": " + ec.message());
+        return;
+    }
+
+    directory = cacheDirectory;
+    driverKey = 14695981039346656037ULL;
+    driverKey = fnv1a(driverKey, glString(GL_VENDOR));
+    driverKey = fnv1a(driverKey, glString(GL_RENDERER));
+    driverKey = fnv1a(driverKey, glString(GL_VERSION));
+    enabled = true;
+    Debug::log("[ShaderCache] Using " + directory);
+}
+
+uint64_t ShaderCache::makeKey(const std::string& vertexSource, const std::string& fragmentSource) const {
+    uint64_t key = fnv1a(driverKey, vertexSource);
+    return fnv1a(key, fragmentSource);
+}
+
+std::string ShaderCache::pathFor(uint64_t key) const {
+    std::ostringstream path;
+    path << directory << "/" << std::hex << key << ".bin";
+    return path.str();
+}
+
+GLuint ShaderCache::load(uint64_t key) {
+    if (!enabled) return 0;
+
+    std::string path = pathFor(key);
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    const auto fileSize = static_cast<uint64_t>(std::max<std::streamoff>(in.tellg(), 0));
+    in.seekg(0);
+    FileHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != FILE_MAGIC || header.version != FILE_VERSION || header.key != key) {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    // A corrupt length must not turn into a huge allocation or a short read
+    if (header.length == 0 || header.length != fileSize - sizeof(FileHeader)) {
+        Debug::logError("[ShaderCache] " + path + " is truncated or corrupt; dropping it");
+        in.close();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    std::vector<char> binary(header.length);
+    if (!in.read(binary.data(), binary.size())) {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        // Drivers may refuse their own binaries after an update that kept the version string
+        glDeleteProgram(program);
+        in.close();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        rejected.fetch_add(1, std::memory_order_relaxed);
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return program;
+}
+
+void ShaderCache::prepareForLink(GLuint program) const {
+    if (enabled) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+}
+
+void ShaderCache::store(uint64_t key, GLuint program) {
+    if (!enabled) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return;
+
+    // Write then rename so a crash never leaves a truncated entry under the real name
+    std::string path = pathFor(key);
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        FileHeader header{FILE_MAGIC, FILE_VERSION, key, format, static_cast<uint32_t>(written)};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(binary.data(), written);
+        if (!out) {
+            Debug::logError("[ShaderCache] Unable to write " + tempPath);
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        Debug::logError("[ShaderCache] Unable to write " + path + ": " + ec.message());
+        return;
+    }
+    writes.fetch_add(1, std::memory_order_relaxed);
+}
+
+ShaderCache::Stats ShaderCache::getStats() const {
+    Stats stats;
+    stats.hits = hits.load(std::memory_order_relaxed);
+    stats.misses = misses.load(std::memory_order_relaxed);
+    stats.rejected = rejected.load(std::memory_order_relaxed);
+    stats.writes = writes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::string ShaderCache::formatStats() const {
+    Stats stats = getStats();
+    if (!enabled) {
+        return "[ShaderCache] disabled";
+    }
+    return "[ShaderCache] hits=" + std::to_string(stats.hits) + " misses=" + std::to_string(stats.misses) +
+           " rejected=" + std::to_string(stats.rejected) + " writes=" + std::to_string(stats.writes);
+}
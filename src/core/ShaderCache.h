@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <glad/glad.h>
+
+// On-disk cache of linked program binaries (glGetProgramBinary/glProgramBinary).
+//
+// Entries are keyed by a hash of the GLSL sources plus the vendor, renderer and
+// version strings, so a driver update or an edited shader never reuses a stale
+// binary. A binary the driver rejects is deleted and the caller compiles from
+// source as before. Disabled until initialize() runs with a current context on
+// a driver that exposes at least one binary format.
+class ShaderCache {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t rejected = 0;  // Loaded from disk but refused by the driver
+        uint64_t writes = 0;
+    };
+
+    static ShaderCache& getInstance();
+
+    // Requires a current GL context; an empty directory leaves the cache disabled
+    void initialize(const std::string& directory);
+    bool isEnabled() const { return enabled; }
+
+    uint64_t makeKey(const std::string& vertexSource, const std::string& fragmentSource) const;
+
+    // Creates a program from the cached binary; 0 on a miss or when the driver refuses it
+    GLuint load(uint64_t key);
+    // Call before glLinkProgram so the driver keeps the binary around
+    void prepareForLink(GLuint program) const;
+    // Writes a successfully linked program's binary
+    void store(uint64_t key, GLuint program);
+
+    Stats getStats() const;
+    std::string formatStats() const;
+
+private:
+    ShaderCache() = default;
+    std::string pathFor(uint64_t key) const;
+
+    bool enabled = false;
+    std::string directory;
+    uint64_t driverKey = 0;
+
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> rejected{0};
+    std::atomic<uint64_t> writes{0};
+};
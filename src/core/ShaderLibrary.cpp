@@ -0,0 +1,43 @@
+#include "ShaderLibrary.h"
+#include "Debug.h"
+
+ShaderLibrary& ShaderLibrary::getInstance() {
+    static ShaderLibrary instance;
+    return instance;
+}
+
+void ShaderLibrary::initialize() {
+    parallelCompile = GLAD_GL_KHR_parallel_shader_compile != 0;
+    if (parallelCompile) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);  // Let the driver pick
+    }
+    Debug::log(std::string("[ShaderLibrary] Parallel shader compile ") + (parallelCompile ? "enabled" : "unavailable"));
+}
+
+void ShaderLibrary::submit(const std::string& vertexPath, const std::string& fragmentPath) {
+    Key key(vertexPath, fragmentPath);
+    if (programs.count(key)) return;
+    programs.emplace(std::move(key), Shader::submit(vertexPath.c_str(), fragmentPath.c_str()));
+}
+
+Shader::PendingProgram ShaderLibrary::take(const std::string& vertexPath, const std::string& fragmentPath) {
+    auto it = programs.find(Key(vertexPath, fragmentPath));
+    if (it == programs.end()) {
+        return Shader::submit(vertexPath.c_str(), fragmentPath.c_str());
+    }
+    Shader::PendingProgram program = it->second;
+    programs.erase(it);
+    return program;
+}
+
+bool ShaderLibrary::isReady(const std::string& vertexPath, const std::string& fragmentPath) const {
+    auto it = programs.find(Key(vertexPath, fragmentPath));
+    return it == programs.end() || Shader::isReady(it->second);
+}
+
+void ShaderLibrary::clear() {
+    for (auto& [key, program] : programs) {
+        Shader untaken(program);  // Resolves nothing; its destructor releases the GL objects
+    }
+    programs.clear();
+}
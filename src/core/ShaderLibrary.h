@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Shader.h"
+
+// Starts every program's compile and link up front so the driver can work on
+// them while the CPU does something else (terrain generation at startup).
+//
+// With GL_KHR_parallel_shader_compile the driver compiles on its own threads
+// and completion is polled through GL_COMPLETION_STATUS_KHR; without it the
+// submissions still avoid the per-shader status round trip that forced each
+// program to finish before the next one started. A Shader constructed for
+// submitted files adopts the in-flight program and only waits on first use.
+class ShaderLibrary {
+public:
+    static ShaderLibrary& getInstance();
+
+    // Requires a current GL context
+    void initialize();
+    bool hasParallelCompile() const { return parallelCompile; }
+
+    // Starts compiling a vertex/fragment pair; repeated pairs are ignored until taken
+    void submit(const std::string& vertexPath, const std::string& fragmentPath);
+
+    // Hands the submitted program to the caller (compiling now if it was never submitted)
+    Shader::PendingProgram take(const std::string& vertexPath, const std::string& fragmentPath);
+
+    // False while a submitted, untaken pair is still compiling; taking it now would wait for the driver
+    bool isReady(const std::string& vertexPath, const std::string& fragmentPath) const;
+
+    // Deletes programs nobody took; call before the context goes away
+    void clear();
+
+private:
+    ShaderLibrary() = default;
+
+    using Key = std::pair<std::string, std::string>;
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return std::hash<std::string>()(key.first) * 31 + std::hash<std::string>()(key.second);
+        }
+    };
+
+    bool parallelCompile = false;
+    std::unordered_map<Key, Shader::PendingProgram, KeyHash> programs;  // Main thread only
+};
@@ -0,0 +1,122 @@
+#include "Simulation.h"
+#include <algorithm>
+#include "Profiler.h"
+#include "Terrain.h"
+
+namespace {
+    uint64_t mixBytes(uint64_t hash, const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+}
+
+Simulation::Simulation(std::shared_ptr<Terrain> terrainPtr, const glm::vec3& spawnPosition)
+    : terrain(std::move(terrainPtr))
+    , body(spawnPosition)
+    , player(&body)
+{
+    manipulator.initialize(terrain);
+    captureState(current);
+    previous = current;
+}
+
+void Simulation::step(const SimInput& input) {
+    PROFILE_SCOPE("Simulation::step");
+    previous = std::move(current);
+
+    body.updateDirection(input.yaw, input.pitch);
+    applyMovement(input);
+
+    glm::vec3 pos = body.getPosition();
+    float groundHeight = terrain ? terrain->sampleEditedHeight(pos.x, pos.z) : 0.0f;
+    player.update(STEP, groundHeight);
+
+    slingshot.update(input, body.getFront(), player);
+    updateLift(input);
+    manipulator.update(STEP);
+
+    ++stepCount;
+    captureState(current);
+}
+
+void Simulation::applyMovement(const SimInput& input) {
+    // Slingshot charging holds the player in place, like a disabled camera used to
+    if (slingshot.isChargingShot()) return;
+
+    const float distance = input.moveSpeed * STEP;
+    if (input.forward) player.moveForward(distance);
+    if (input.backward) player.moveBackward(distance);
+    if (input.left) player.moveLeft(distance);
+    if (input.right) player.moveRight(distance);
+
+    if (input.toggleFly) player.toggleFlyMode();
+    if (input.jump) player.jump();
+
+    if (player.isInFlyMode()) {
+        if (input.flyDown) player.moveDown(distance);
+        if (input.flyUp) player.moveUp(distance);
+    }
+}
+
+void Simulation::updateLift(const SimInput& input) {
+    if (!input.liftHeld) {
+        // Released before the threshold
+        liftTriggered = false;
+        liftHoldTime = 0.0f;
+        return;
+    }
+    if (!liftTriggered) {
+        liftTriggered = true;
+        liftHoldTime = 0.0f;
+        return;
+    }
+
+    liftHoldTime += STEP;
+    if (liftHoldTime < LIFT_HOLD_SECONDS || !terrain) return;
+
+    // Keeps trying every step until the player aims at the ground
+    if (auto hit = terrain->raycastEdited(body.getPosition(), body.getFront(), 100.0f)) {
+        manipulator.beginLift(*hit);
+        liftTriggered = false;
+        liftHoldTime = 0.0f;
+    }
+}
+
+void Simulation::captureState(State& state) const {
+    state.playerPosition = body.getPosition();
+    manipulator.getGlobs(state.globs);
+}
+
+Simulation::State Simulation::interpolate(float alpha) const {
+    alpha = std::clamp(alpha, 0.0f, 1.0f);
+    State blended;
+    blended.playerPosition = glm::mix(previous.playerPosition, current.playerPosition, alpha);
+
+    // Both lists ascend by id, so one merge pass pairs up the globs present in both
+    blended.globs = current.globs;
+    auto prev = previous.globs.begin();
+    for (auto& glob : blended.globs) {
+        while (prev != previous.globs.end() && prev->id < glob.id) ++prev;
+        if (prev != previous.globs.end() && prev->id == glob.id) {
+            glob.position = glm::mix(prev->position, glob.position, alpha);
+        }
+    }
+    return blended;
+}
+
+uint64_t Simulation::getChecksum() const {
+    uint64_t hash = 1469598103934665603ULL;
+    glm::vec3 position = body.getPosition();
+    glm::vec3 velocity = player.getVelocity();
+    bool flags[3] = {player.isGrounded(), player.isInFlyMode(), slingshot.isChargingShot()};
+    hash = mixBytes(hash, &position, sizeof(position));
+    hash = mixBytes(hash, &velocity, sizeof(velocity));
+    hash = mixBytes(hash, flags, sizeof(flags));
+    hash = mixBytes(hash, &liftHoldTime, sizeof(liftHoldTime));
+    hash = mixBytes(hash, &stepCount, sizeof(stepCount));
+    return manipulator.hashState(hash);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Camera.h"
+#include "Player.h"
+#include "SlingshotController.h"
+#include "TerrainManipulator.h"
+
+class Terrain;
+
+// Everything a fixed step reads from the player, sampled once per frame on the main thread.
+// Edge flags stay set until a step consumes them, so a frame that runs no step loses nothing.
+struct SimInput {
+    float yaw = -90.0f;  // Look direction in degrees, as InputManager tracks it
+    float pitch = 0.0f;
+    bool lookFree = true;  // Mouse look active (no UI holding the camera)
+    float moveSpeed = 5.0f;
+
+    bool forward = false, backward = false, left = false, right = false;
+    bool flyUp = false, flyDown = false;  // Held: space / shift while flying
+    bool jump = false;                    // Edge
+    bool toggleFly = false;               // Edge
+
+    bool slingshotHeld = false;  // Both mouse buttons
+    float cursorY = 0.0f;        // Drag distance sets the slingshot charge
+    bool liftHeld = false;       // Right mouse; lifts a glob after LIFT_HOLD_SECONDS
+
+    void clearEdges() { jump = toggleFly = false; }
+};
+
+// Player, slingshot and earth-glob gameplay stepped at a fixed rate.
+//
+// Nothing here touches GLFW or GL, so it runs headless (tests, replays) as fast
+// as the terrain queries allow. The same input sequence from the same start
+// produces bit-identical states; getChecksum() makes that cheap to compare.
+// Ground and aim queries go through Terrain's edited-height functions rather
+// than the chunk meshes, and brush edits land in the edit overlay during the
+// step, so neither streaming nor remeshing on workers can change an outcome.
+// The renderer draws interpolate(alpha) between the last two steps instead of
+// stepping with the frame time, so a slow frame only delays what is shown.
+class Simulation {
+public:
+    static constexpr float STEP = 1.0f / 60.0f;
+    static constexpr float LIFT_HOLD_SECONDS = 3.0f;
+
+    // What the renderer needs from one step
+    struct State {
+        glm::vec3 playerPosition{0.0f};
+        std::vector<TerrainManipulator::GlobState> globs;  // Ascending id
+    };
+
+    Simulation(std::shared_ptr<Terrain> terrain, const glm::vec3& spawnPosition);
+    Simulation(const Simulation&) = delete;  // The player points at body
+    Simulation& operator=(const Simulation&) = delete;
+
+    void step(const SimInput& input);
+
+    // alpha in [0, 1]: 0 is the previous step, 1 the latest. Globs that exist in only one of
+    // the two steps are drawn where they are.
+    State interpolate(float alpha) const;
+    const State& getState() const { return current; }
+    uint64_t getStepCount() const { return stepCount; }
+    // FNV-1a over the raw bits of everything the steps evolve
+    uint64_t getChecksum() const;
+
+    const Player& getPlayer() const { return player; }
+    const Camera& getBody() const { return body; }  // Player position and facing
+    bool isSlingshotCharging() const { return slingshot.isChargingShot(); }
+    // Lift progress for UI feedback, 0 when the button is up
+    float getLiftHoldTime() const { return liftHoldTime; }
+
+private:
+    void applyMovement(const SimInput& input);
+    void updateLift(const SimInput& input);
+    void captureState(State& state) const;
+
+    std::shared_ptr<Terrain> terrain;
+    Camera body;
+    Player player;
+    SlingshotController slingshot;
+    TerrainManipulator manipulator;
+    float liftHoldTime = 0.0f;
+    bool liftTriggered = false;
+
+    State previous;
+    State current;
+    uint64_t stepCount = 0;
+};
@@ -1,40 +1,26 @@
 #include "SlingshotController.h"
 #include <algorithm> 
-#include <iostream>
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include "InputManager.h"
-#include "Camera.h"
 #include "Player.h"
+#include "Simulation.h"
 
-void SlingshotController::update(GLFWwindow* window, Camera& camera, Player& player) {
-    bool leftDown  = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT)  == GLFW_PRESS;
-    bool rightDown = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS;
-    bool bothDown = leftDown && rightDown;
-
-    // Start charging
-    if (bothDown && !isCharging && InputManager::getCameraState() == CameraState::Free) {
+void SlingshotController::update(const SimInput& input, const glm::vec3& front, Player& player) {
+    // Start charging; the application disables mouse look while isChargingShot()
+    if (input.slingshotHeld && !isCharging && input.lookFree) {
         isCharging = true;
         chargeAmount = 0.0f;
-        double mouseX;
-        glfwGetCursorPos(window, &mouseX, &initialMouseY);
-        lockedDirection = glm::normalize(camera.getFront());
-        chargingViewLocked = true;
-        InputManager::setCameraState(CameraState::Disabled);
+        initialMouseY = input.cursorY;
+        lockedDirection = glm::normalize(front);
     }
 
     // Update charge while holding
-    if (isCharging && bothDown) {
-        double mouseX, currentMouseY;
-        glfwGetCursorPos(window, &mouseX, &currentMouseY);
-        double deltaY = currentMouseY - initialMouseY;
-        chargeAmount = std::clamp(static_cast<float>(deltaY) * chargeMultiplier, 0.0f, maxCharge);
+    if (isCharging && input.slingshotHeld) {
+        float deltaY = input.cursorY - initialMouseY;
+        chargeAmount = std::clamp(deltaY * chargeMultiplier, 0.0f, maxCharge);
     }
 
     // Release and launch
-    if (isCharging && (!bothDown || InputManager::getCameraState() != CameraState::Disabled)) {
+    if (isCharging && !input.slingshotHeld) {
         if (chargeAmount > 0.0f) {
             glm::vec3 force = lockedDirection * chargeAmount * powerFactor;
             player.applyForce(force);
@@ -44,13 +30,5 @@ void SlingshotController::update(GLFWwindow* window, Camera& camera, Player& pla
         isCharging = false;
         chargeAmount = 0.0f;
         lockedDirection = glm::vec3(0.0f);
-        chargingViewLocked = false;
-        
-        // Only reset camera state if we were the ones who disabled it
-        if (InputManager::getCameraState() == CameraState::Disabled) {
-            InputManager::setCameraState(CameraState::Free);
-        }
     }
-
-    wasChargingLastFrame = isCharging;
 }
@@ -2,23 +2,23 @@
 
 #include <glm/glm.hpp>
 
-struct GLFWwindow;
-class Camera;
 class Player;
+struct SimInput;
 
+// Hold both mouse buttons and drag down to charge; release to launch the player
+// along the direction they faced when charging began. Stepped by Simulation.
 class SlingshotController {
 public:
-    void update(GLFWwindow* window, Camera& camera, Player& player);
+    void update(const SimInput& input, const glm::vec3& front, Player& player);
+    bool isChargingShot() const { return isCharging; }
 
 private:
     bool isCharging = false;
-    bool wasChargingLastFrame = false;
-    double initialMouseY = 0.0;
+    float initialMouseY = 0.0f;
     float chargeAmount = 0.0f;
     glm::vec3 lockedDirection = glm::vec3(0.0f);
-    bool chargingViewLocked = false;
     
     const float chargeMultiplier = 0.3f;
     const float maxCharge = 100.0f;
     const float powerFactor = 30.0f;
-};
\ No newline at end of file
+};
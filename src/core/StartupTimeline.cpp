@@ -0,0 +1,97 @@
+#include "StartupTimeline.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include "Debug.h"
+
+StartupTimeline& StartupTimeline::getInstance() {
+    static StartupTimeline instance;
+    return instance;
+}
+
+StartupTimeline::StartupTimeline()
+    : origin(std::chrono::steady_clock::now())
+    , mainThreadId(std::this_thread::get_id())
+{
+}
+
+void StartupTimeline::record(const char* name, double startMs, double endMs) {
+    bool onMainThread = std::this_thread::get_id() == mainThreadId;
+    std::lock_guard<std::mutex> lock(mutex);
+    phases.push_back({name, startMs, endMs - startMs, onMainThread});
+}
+
+void StartupTimeline::markFirstFrame() {
+    double now = nowMs();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (firstFrameMs < 0.0) {
+        firstFrameMs = now;
+    }
+}
+
+bool StartupTimeline::hasFirstFrame() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return firstFrameMs >= 0.0;
+}
+
+double StartupTimeline::getFirstFrameMs() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return firstFrameMs;
+}
+
+std::vector<StartupTimeline::Phase> StartupTimeline::getPhases() const {
+    std::vector<Phase> sorted;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sorted = phases;
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const Phase& a, const Phase& b) { return a.startMs < b.startMs; });
+    return sorted;
+}
+
+std::string StartupTimeline::formatReport() const {
+    std::vector<Phase> sorted = getPhases();
+    double firstFrame = getFirstFrameMs();
+
+    std::string report = "[Startup] ";
+    report += firstFrame >= 0.0 ? "first frame at " + std::to_string(static_cast<int>(firstFrame)) + " ms"
+                                : std::string("no frame presented yet");
+    char line[160];
+    for (const Phase& phase : sorted) {
+        // Anything that finished after the first frame did not delay it
+        bool deferred = firstFrame >= 0.0 && phase.startMs + phase.durationMs > firstFrame;
+        std::snprintf(line, sizeof(line), "\n  %8.1f ms  %8.1f ms  %s%s%s", phase.startMs, phase.durationMs,
+                      phase.name, deferred ? " (deferred)" : "", phase.mainThread ? "" : " [worker]");
+        report += line;
+    }
+    return report;
+}
+
+bool StartupTimeline::exportTrace(const std::string& path) const {
+    std::vector<Phase> sorted = getPhases();
+    double firstFrame = getFirstFrameMs();
+
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        Debug::logError("[Startup] Unable to write timeline to " + path);
+        return false;
+    }
+
+    // Chrome trace-event format in microseconds; main thread is tid 0, workers share tid 1
+    out << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"main\"}},"
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"workers\"}}";
+    for (const Phase& phase : sorted) {
+        out << ",{\"name\":\"" << phase.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << (phase.mainThread ? 0 : 1)
+            << ",\"ts\":" << phase.startMs * 1e3 << ",\"dur\":" << phase.durationMs * 1e3 << "}";
+    }
+    if (firstFrame >= 0.0) {
+        out << ",{\"name\":\"first frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":" << firstFrame * 1e3 << "}";
+    }
+    out << "]}\n";
+
+    Debug::log("[Startup] Wrote timeline to " + path);
+    return static_cast<bool>(out);
+}
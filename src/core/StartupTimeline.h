@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Profiler.h"
+
+// Wall-clock phases from process start to the first frame and beyond.
+//
+// Startup code wraps each phase in STARTUP_PHASE; phases may finish on any
+// thread (deferred fast-boot work runs on the pool or between frames). The
+// first presented frame splits the report into what the player waited for and
+// what was deferred. exportTrace() writes the same Chrome trace-event JSON as
+// the Profiler so both open in Perfetto.
+class StartupTimeline {
+public:
+    struct Phase {
+        const char* name;  // Must outlive the timeline (string literals)
+        double startMs;    // Since the timeline was created
+        double durationMs;
+        bool mainThread;
+    };
+
+    static StartupTimeline& getInstance();
+
+    double nowMs() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    void record(const char* name, double startMs, double endMs);
+
+    // First call wins; later calls are ignored
+    void markFirstFrame();
+    bool hasFirstFrame() const;
+    double getFirstFrameMs() const;
+
+    std::vector<Phase> getPhases() const;
+
+    // One line per phase in start order, deferred phases flagged
+    std::string formatReport() const;
+    bool exportTrace(const std::string& path) const;
+
+private:
+    StartupTimeline();
+
+    std::chrono::steady_clock::time_point origin;
+    std::thread::id mainThreadId;
+    mutable std::mutex mutex;  // Startup only: phases are few and coarse
+    std::vector<Phase> phases;
+    double firstFrameMs = -1.0;
+};
+
+class StartupPhaseScope {
+public:
+    explicit StartupPhaseScope(const char* name)
+        : name(name), startMs(StartupTimeline::getInstance().nowMs()) {}
+    ~StartupPhaseScope() {
+        StartupTimeline& timeline = StartupTimeline::getInstance();
+        timeline.record(name, startMs, timeline.nowMs());
+    }
+
+    StartupPhaseScope(const StartupPhaseScope&) = delete;
+    StartupPhaseScope& operator=(const StartupPhaseScope&) = delete;
+
+private:
+    const char* name;
+    double startMs;
+};
+
+#define STARTUP_PHASE(name) StartupPhaseScope PROFILE_CONCAT(startupPhase_, __LINE__)(name)
@@ -8,28 +8,21 @@
 #include <vector>
 #include <atomic>
 #include <memory>
-#include <unordered_set>
 #include <utility>
 #include <chrono>
+#include "Chunk.h"
+#include "Debug.h"
+#include "Profiler.h"
+#include "RingQueue.h"
+#include "ScratchArena.h"
 #include "Terrain.h"
 
-// Hash function for chunk coordinates
-struct ChunkPairHash {
-    template <class T1, class T2>
-    std::size_t operator()(const std::pair<T1, T2>& p) const {
-        auto h1 = std::hash<T1>{}(p.first);
-        auto h2 = std::hash<T2>{}(p.second);
-        return h1 ^ (h2 << 1);
-    }
-};
-
 class TerrainThreadPool {
 public:
     TerrainThreadPool(size_t numThreads = std::thread::hardware_concurrency() - 1)
         : shouldStop(false)
         , lastUploadTime(std::chrono::steady_clock::now())
         , uploadBudgetMs(16.0f) // Target ~60 FPS
-        , chunkUpdateCooldown(100) // 100ms cooldown between updates for same chunk
     {
         for (size_t i = 0; i < numThreads; ++i) {
             workers.emplace_back([this, i] { workerFunction(i); });
@@ -47,71 +40,50 @@ public:
         }
     }
 
-    virtual void queueChunkUpdate(int chunkX, int chunkZ, std::shared_ptr<Terrain> terrain) {
-        // Skip if too many pending uploads
-        if (getPendingUploadCount() > 32) {
+    // Generates the chunk once on a worker, then hands it to processUploads(). Chunks that were
+    // already queued or generated are ignored, so callers can request freely. Chunks travel in
+    // their own ring queues rather than as std::function tasks, so streaming doesn't allocate.
+    virtual void queueChunkGeneration(std::shared_ptr<Chunk> chunk) {
+        if (!chunk || !chunk->requestGeneration()) {
             return;
         }
 
-        // Check cooldown for this chunk
-        auto now = std::chrono::steady_clock::now();
-        auto key = std::make_pair(chunkX, chunkZ);
         {
-            std::lock_guard<std::mutex> lock(processingMutex);
-            auto lastUpdate = lastUpdateTime.find(key);
-            if (lastUpdate != lastUpdateTime.end()) {
-                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    now - lastUpdate->second).count();
-                if (elapsed < chunkUpdateCooldown) {
-                    return; // Skip if too soon
-                }
-            }
+            std::lock_guard<std::mutex> lock(queueMutex);
+            generationQueue.push(std::move(chunk));
         }
+        condition.notify_one();
+    }
 
-        // Check if this chunk is already being processed
-        {
-            std::lock_guard<std::mutex> lock(processingMutex);
-            if (processingChunks.find(key) != processingChunks.end()) {
-                return; // Skip if already being processed
+    // Runs queued work on the calling thread until both queues are empty, so a pool
+    // without workers (tests, headless tools) still makes progress; returns the count
+    size_t runPendingTasks() {
+        size_t ran = 0;
+        std::function<void()> task;
+        std::shared_ptr<Chunk> chunk;
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                if (!popWork(task, chunk)) break;
             }
-            processingChunks.insert(key);
-            lastUpdateTime[key] = now;
+            runWork(task, chunk);
+            ++ran;
         }
+        return ran;
+    }
 
+    // Run arbitrary terrain work (e.g. edit remeshing) on a worker
+    virtual void queueTask(std::function<void()> task) {
         {
             std::lock_guard<std::mutex> lock(queueMutex);
-            tasks.push([this, chunkX, chunkZ, terrain] {
-                auto chunk = terrain->getChunks().find({chunkX, chunkZ});
-                if (chunk != terrain->getChunks().end()) {
-                    try {
-                        // Only generate if not already uploaded
-                        if (!chunk->second->isUploaded()) {
-                            chunk->second->generate();
-                            
-                            // Queue for GPU upload on main thread
-                            {
-                                std::lock_guard<std::mutex> uploadLock(uploadMutex);
-                                uploadQueue.push({chunk->second, std::chrono::steady_clock::now()});
-                            }
-                        }
-                    }
-                    catch (const std::exception&) {
-                        // Handle error silently
-                    }
-                }
-
-                // Remove from processing set
-                {
-                    std::lock_guard<std::mutex> lock(processingMutex);
-                    processingChunks.erase({chunkX, chunkZ});
-                }
-            });
+            tasks.push(std::move(task));
         }
         condition.notify_one();
     }
 
     // Call this from the main thread to process GPU uploads
     virtual void processUploads() {
+        PROFILE_SCOPE("TerrainThreadPool::processUploads");
         using namespace std::chrono;
 
         auto currentTime = steady_clock::now();
@@ -120,7 +92,7 @@ public:
             return;
         }
 
-        std::vector<std::shared_ptr<Chunk>> chunksToUpload;
+        std::vector<std::shared_ptr<Chunk>>& chunksToUpload = uploadBatch;
         {
             std::lock_guard<std::mutex> lock(uploadMutex);
             
@@ -130,15 +102,15 @@ public:
             
             auto now = steady_clock::now();
             while (!uploadQueue.empty() && count < maxChunksPerFrame) {
-                auto& [chunk, timestamp] = uploadQueue.front();
+                PendingUpload& pending = uploadQueue.front();
                 
                 // Reduced minimum age requirement
-                auto age = duration_cast<milliseconds>(now - timestamp).count();
+                auto age = duration_cast<milliseconds>(now - pending.queuedAt).count();
                 if (age < 8) { // Was 16ms
                     break;
                 }
                 
-                chunksToUpload.push_back(chunk);
+                chunksToUpload.push_back(std::move(pending.chunk));
                 uploadQueue.pop();
                 count++;
             }
@@ -148,13 +120,9 @@ public:
             auto uploadStart = steady_clock::now();
             
             for (const auto& chunk : chunksToUpload) {
-                try {
-                    if (!chunk->isUploaded()) {
-                        chunk->uploadToGPU();
-                    }
-                }
-                catch (const std::exception&) {
-                    // Handle error silently
+                // Skips chunks unloaded since generation
+                if (chunk->getState() == Chunk::State::Generated) {
+                    chunk->uploadToGPU();
                 }
             }
             
@@ -163,13 +131,12 @@ public:
             
             // Adjust upload budget based on actual upload time
             uploadBudgetMs = std::max(16.0f, uploadDuration * 1.5f);
+            chunksToUpload.clear();  // Keeps its capacity for the next frame
         }
     }
 
-    // Check if a chunk is currently being processed
-    virtual bool isChunkProcessing(int x, int z) const {
-        std::lock_guard<std::mutex> lock(processingMutex);
-        return processingChunks.find({x, z}) != processingChunks.end();
+    virtual size_t getWorkerCount() const {
+        return workers.size();
     }
 
     // Get number of chunks waiting to be uploaded
@@ -179,41 +146,85 @@ public:
     }
 
 private:
+    struct PendingUpload {
+        std::shared_ptr<Chunk> chunk;
+        std::chrono::steady_clock::time_point queuedAt;
+    };
+
+    // Takes the next task, or failing that the next chunk to generate; queueMutex must be held
+    bool popWork(std::function<void()>& task, std::shared_ptr<Chunk>& chunk) {
+        if (!tasks.empty()) {
+            task = std::move(tasks.front());
+            tasks.pop();
+            return true;
+        }
+        if (!generationQueue.empty()) {
+            chunk = std::move(generationQueue.front());
+            generationQueue.pop();
+            return true;
+        }
+        return false;
+    }
+
+    // Runs what popWork returned and releases it
+    void runWork(std::function<void()>& task, std::shared_ptr<Chunk>& chunk) {
+        PROFILE_SCOPE("TerrainThreadPool::task");
+        if (task) {
+            task();
+            task = nullptr;
+        } else if (chunk) {
+            generateChunk(std::move(chunk));
+        }
+    }
+
+    void generateChunk(std::shared_ptr<Chunk> chunk) {
+        // Unloaded while waiting in the queue: nothing to do
+        if (chunk->getState() != Chunk::State::Queued) {
+            return;
+        }
+        try {
+            chunk->generate();
+        }
+        catch (const std::exception& e) {
+            Debug::logError(std::string("[TerrainThreadPool] Chunk generation failed: ") + e.what());
+            return;
+        }
+
+        // Queue for GPU upload on main thread
+        std::lock_guard<std::mutex> uploadLock(uploadMutex);
+        uploadQueue.push({std::move(chunk), std::chrono::steady_clock::now()});
+    }
+
     void workerFunction(size_t threadId) {
+        std::function<void()> task;
+        std::shared_ptr<Chunk> chunk;
         while (true) {
-            std::function<void()> task;
             {
                 std::unique_lock<std::mutex> lock(queueMutex);
                 condition.wait(lock, [this] {
-                    return shouldStop || !tasks.empty();
+                    return shouldStop || !tasks.empty() || !generationQueue.empty();
                 });
                 
-                if (shouldStop && tasks.empty()) {
-                    return;
+                if (!popWork(task, chunk)) {
+                    return;  // Stopping with nothing left
                 }
-                
-                task = std::move(tasks.front());
-                tasks.pop();
             }
-            task();
+            runWork(task, chunk);
+            ScratchArena::forThread().reset();  // Scratch never outlives a task
         }
     }
 
     std::queue<std::function<void()>> tasks;
-    std::queue<std::pair<std::shared_ptr<Chunk>, std::chrono::steady_clock::time_point>> uploadQueue;
+    RingQueue<std::shared_ptr<Chunk>> generationQueue;
+    RingQueue<PendingUpload> uploadQueue;
+    std::vector<std::shared_ptr<Chunk>> uploadBatch;  // Main thread; reused by processUploads
     std::vector<std::thread> workers;
     std::mutex queueMutex;
     mutable std::mutex uploadMutex;
-    mutable std::mutex processingMutex;
     std::condition_variable condition;
     std::atomic<bool> shouldStop;
-    std::unordered_set<std::pair<int, int>, ChunkPairHash> processingChunks;
-    
+
     // Timing control for GPU uploads
     std::chrono::steady_clock::time_point lastUploadTime;
     float uploadBudgetMs;
-
-    // Add these members
-    std::unordered_map<std::pair<int, int>, std::chrono::steady_clock::time_point, ChunkPairHash> lastUpdateTime;
-    const int chunkUpdateCooldown; // milliseconds
 }; 
\ No newline at end of file
@@ -1,10 +1,14 @@
 #include "EarthGlob.h"
 #include <glm/gtc/matrix_transform.hpp>
 
-void EarthGlob::initialize(const glm::vec3& startPos) {
-    position = startPos;
-    velocity = glm::vec3(0.0f, liftSpeed, 0.0f); // Initial upward velocity
+EarthGlob::~EarthGlob() {
+    if (VAO == 0) return;
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &EBO);
+}
 
+void EarthGlob::initialize() {
     // Create a cube mesh for the glob with 36 vertices (6 faces * 2 triangles * 3 vertices)
     float cubeSize = size;
     float cube[] = {
@@ -78,28 +82,9 @@ void EarthGlob::initialize(const glm::vec3& startPos) {
     shader = std::make_unique<Shader>("shaders/debug_marker.vert", "shaders/debug_marker.frag");
 }
 
-void EarthGlob::update(float deltaTime) {
-    // Apply velocity
-    position += velocity * deltaTime;
-    
-    // Add some random movement
-    float wobbleAmount = 0.1f;
-    velocity.x += (rand() / (float)RAND_MAX - 0.5f) * wobbleAmount;
-    velocity.z += (rand() / (float)RAND_MAX - 0.5f) * wobbleAmount;
-    
-    // Clamp horizontal velocity
-    float maxHorizontalSpeed = 2.0f;
-    glm::vec2 horizontalVel(velocity.x, velocity.z);
-    if (glm::length(horizontalVel) > maxHorizontalSpeed) {
-        horizontalVel = glm::normalize(horizontalVel) * maxHorizontalSpeed;
-        velocity.x = horizontalVel.x;
-        velocity.z = horizontalVel.y;
-    }
-}
+void EarthGlob::render(const glm::vec3& position, const glm::mat4& view, const glm::mat4& projection) {
+    if (!shader) return;
 
-void EarthGlob::render(const glm::mat4& view, const glm::mat4& projection) {
-    if (!active) return;
-    
     shader->use();
     glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
     
@@ -4,22 +4,17 @@
 #include <memory>
 #include "Shader.h"
 
+// Cube mesh for lifted earth globs. Glob motion lives in TerrainManipulator
+// (simulation); one mesh draws every glob at the positions it is given.
 class EarthGlob {
 public:
-    void initialize(const glm::vec3& startPos);
-    void update(float deltaTime);
-    void render(const glm::mat4& view, const glm::mat4& projection);
-    
-    // Getters for position and state
-    glm::vec3 getPosition() const { return position; }
-    bool isActive() const { return active; }
+    ~EarthGlob();
+
+    void initialize();
+    void render(const glm::vec3& position, const glm::mat4& view, const glm::mat4& projection);
 
 private:
-    glm::vec3 position;
-    glm::vec3 velocity{0.0f};
-    float liftSpeed = 1.5f;
     float size = 0.5f;  // Make the glob a bit smaller
-    bool active = true;
     
     // OpenGL resources
     GLuint VAO = 0;
@@ -26,6 +26,7 @@ public:
     // Getters
     bool isGrounded() const { return grounded; }
     bool isInFlyMode() const { return flyMode; }
+    const glm::vec3& getVelocity() const { return velocity; }
     const glm::vec3& getPosition() const { return camera->getPosition(); }
     
     // Camera access (for rendering and input systems)
@@ -1,8 +1,30 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h> 
+#include <cstring>
 #include "Application.h"
+#include "Config.h"
+#include "StartupTimeline.h"
+
+int main(int argc, char** argv) {
+    StartupTimeline::getInstance();  // Timeline origin is process start
+
+    // --fast-boot, --startup-timeline=<path>, --record-input=<path>, --replay-input=<path> and
+    // --replay-report=<path> override the config
+    Config& config = Config::getInstance();
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--fast-boot") == 0) {
+            config.game.fastBoot = true;
+        } else if (std::strncmp(argv[i], "--startup-timeline=", 19) == 0) {
+            config.game.startupTimelinePath = argv[i] + 19;
+        } else if (std::strncmp(argv[i], "--record-input=", 15) == 0) {
+            config.game.inputRecordPath = argv[i] + 15;
+        } else if (std::strncmp(argv[i], "--replay-input=", 15) == 0) {
+            config.game.inputReplayPath = argv[i] + 15;
+        } else if (std::strncmp(argv[i], "--replay-report=", 16) == 0) {
+            config.game.replayReportPath = argv[i] + 16;
+        }
+    }
 
-int main() {
     Application app;
     app.run();
     return 0;
@@ -1,14 +1,22 @@
 #include "BiomeManager.h"
 #include <glm/gtx/norm.hpp>
-#include <glm/gtc/random.hpp> // For linearRand
+#include <random>
 #include "TerrainConstants.h"
+#include "WorldConstants.h"
 
 void BiomeManager::initialize(int numBiomes, int worldSize) {
     biomeCenters.clear();
 
+    // Seeded, and mapped by hand rather than through a distribution (those differ between
+    // standard libraries), so every run and every machine lays out the same world
+    std::mt19937 generator(static_cast<uint32_t>(WorldConstants::SEED));
+    auto nextCoordinate = [&generator, worldSize] {
+        return static_cast<float>(generator() >> 8) / static_cast<float>(1u << 24) * static_cast<float>(worldSize);
+    };
+
     for (int i = 0; i < numBiomes; ++i) {
-        float x = glm::linearRand(0.0f, static_cast<float>(worldSize));
-        float z = glm::linearRand(0.0f, static_cast<float>(worldSize));
+        float x = nextCoordinate();
+        float z = nextCoordinate();
         
         TerrainType type = static_cast<TerrainType>(i % 2 == 0 ? TerrainType::Mountains : TerrainType::Plains);
         biomeCenters.emplace_back(glm::vec2(x, z), Biome(type));
@@ -39,8 +47,8 @@ const std::vector<std::pair<glm::vec2, Biome>>& BiomeManager::getBiomeCenters()
     return biomeCenters;
 }
 
-std::map<TerrainType, float> BiomeManager::getBiomeWeightsAt(float x, float z) const {
-    std::map<TerrainType, float> weights;
+std::pmr::map<TerrainType, float> BiomeManager::getBiomeWeightsAt(float x, float z, std::pmr::memory_resource* resource) const {
+    std::pmr::map<TerrainType, float> weights(resource);
 
     const float influenceRadius = 200.0f;
     float totalWeight = 0.0f;
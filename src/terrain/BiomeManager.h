@@ -1,5 +1,6 @@
 #pragma once
 #include <map>
+#include <memory_resource>
 #include <vector>
 #include <glm/glm.hpp>
 #include "Biome.h"
@@ -11,7 +12,8 @@ public:
     const Biome& getBiomeForPosition(float x, float z) const;
     TerrainType getTerrainType(float x, float z) const;
     const std::vector<std::pair<glm::vec2, Biome>>& getBiomeCenters() const;
-    std::map<TerrainType, float> getBiomeWeightsAt(float x, float z) const;
+    std::pmr::map<TerrainType, float> getBiomeWeightsAt(float x, float z,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
 
 
 private:
@@ -0,0 +1,228 @@
+#include "ChunkCache.h"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include "ChunkConstants.h"
+#include "Debug.h"
+
+namespace {
+    constexpr uint8_t ENCODING_PREDICTED = 2;
+    constexpr size_t PAYLOAD_HEADER = 5;  // u32 count + u8 encoding
+
+    int floorDiv(int value, int divisor) {
+        return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+    }
+
+    uint64_t regionKey(int regionX, int regionZ) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(regionX)) << 32) | static_cast<uint32_t>(regionZ);
+    }
+}
+
+ChunkCache::ChunkCache(const std::string& rootDirectory, uint64_t worldKey)
+    : worldKey(worldKey)
+{
+    std::ostringstream dir;
+    dir << rootDirectory << "/" << std::hex << worldKey;
+    directory = dir.str();
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        Debug::logError("[ChunkCache] Unable to create " + directory + ": " + ec.message());
+    }
+
+    writer = std::thread([this] { writerLoop(); });
+    Debug::log("[ChunkCache] Using " + directory);
+}
+
+ChunkCache::~ChunkCache() {
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        shouldStop = true;
+    }
+    writeCondition.notify_all();
+    if (writer.joinable()) {
+        writer.join();
+    }
+
+    Stats stats = getStats();
+    Debug::log("[ChunkCache] hits=" + std::to_string(stats.hits) + " misses=" + std::to_string(stats.misses) +
+               " writes=" + std::to_string(stats.writes) + " bytes=" + std::to_string(stats.storedBytes) +
+               "/" + std::to_string(stats.rawBytes));
+}
+
+RegionFile& ChunkCache::regionFor(int chunkX, int chunkZ, int& localX, int& localZ) {
+    int regionX = floorDiv(chunkX, RegionFile::REGION_SIZE);
+    int regionZ = floorDiv(chunkZ, RegionFile::REGION_SIZE);
+    localX = chunkX - regionX * RegionFile::REGION_SIZE;
+    localZ = chunkZ - regionZ * RegionFile::REGION_SIZE;
+
+    std::lock_guard<std::mutex> lock(regionMutex);
+    auto& region = regions[regionKey(regionX, regionZ)];
+    if (!region) {
+        std::string path = directory + "/r." + std::to_string(regionX) + "." + std::to_string(regionZ) + ".trg";
+        region = std::make_unique<RegionFile>(path, worldKey);
+    }
+    return *region;
+}
+
+bool ChunkCache::load(int chunkX, int chunkZ, std::pmr::vector<float>& heights) {
+    int localX = 0, localZ = 0;
+    RegionFile& region = regionFor(chunkX, chunkZ, localX, localZ);
+
+    const size_t expected = static_cast<size_t>(ChunkConstants::SIZE + 1) * (ChunkConstants::SIZE + 1);
+    bool found = region.read(localX, localZ, [&](const uint8_t* data, size_t size) {
+        return decodeHeights(data, size, heights) && heights.size() == expected;
+    });
+
+    (found ? hits : misses).fetch_add(1, std::memory_order_relaxed);
+    return found;
+}
+
+void ChunkCache::store(int chunkX, int chunkZ, std::vector<float> heights) {
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        pendingWrites.push({chunkX, chunkZ, std::move(heights)});
+    }
+    writeCondition.notify_one();
+}
+
+void ChunkCache::flush() {
+    std::unique_lock<std::mutex> lock(writeMutex);
+    idleCondition.wait(lock, [this] { return pendingWrites.empty() && !writerBusy; });
+}
+
+ChunkCache::Stats ChunkCache::getStats() const {
+    Stats stats;
+    stats.hits = hits.load(std::memory_order_relaxed);
+    stats.misses = misses.load(std::memory_order_relaxed);
+    stats.writes = writes.load(std::memory_order_relaxed);
+    stats.rawBytes = rawBytes.load(std::memory_order_relaxed);
+    stats.storedBytes = storedBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ChunkCache::writerLoop() {
+    std::vector<uint8_t> encoded;
+    while (true) {
+        PendingWrite job;
+        {
+            std::unique_lock<std::mutex> lock(writeMutex);
+            writeCondition.wait(lock, [this] { return shouldStop || !pendingWrites.empty(); });
+            if (pendingWrites.empty()) {
+                return;  // Only reached when stopping; queued writes are drained first
+            }
+            job = std::move(pendingWrites.front());
+            pendingWrites.pop();
+            writerBusy = true;
+        }
+
+        encodeHeights(job.heights, encoded);
+        int localX = 0, localZ = 0;
+        RegionFile& region = regionFor(job.chunkX, job.chunkZ, localX, localZ);
+        if (region.write(localX, localZ, encoded.data(), encoded.size())) {
+            writes.fetch_add(1, std::memory_order_relaxed);
+            rawBytes.fetch_add(job.heights.size() * sizeof(float), std::memory_order_relaxed);
+            storedBytes.fetch_add(encoded.size(), std::memory_order_relaxed);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(writeMutex);
+            writerBusy = false;
+        }
+        idleCondition.notify_all();
+    }
+}
+
+namespace {
+    // Map float bits onto unsigned integers that sort like the floats they encode
+    uint32_t orderedBits(float value) {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, 4);
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+    float fromOrderedBits(uint32_t ordered) {
+        uint32_t bits = (ordered & 0x80000000u) ? (ordered & 0x7FFFFFFFu) : ~ordered;
+        float value = 0.0f;
+        std::memcpy(&value, &bits, 4);
+        return value;
+    }
+
+    // Square grids use the left + up - upLeft gradient predictor, anything else predicts from the left
+    uint32_t gridWidth(uint32_t count) {
+        uint32_t width = static_cast<uint32_t>(std::lround(std::sqrt(static_cast<double>(count))));
+        return width * width == count ? width : count;
+    }
+
+    int64_t predict(const uint32_t* values, uint32_t index, uint32_t width) {
+        uint32_t x = index % width;
+        uint32_t z = index / width;
+        if (x > 0 && z > 0) {
+            return static_cast<int64_t>(values[index - 1]) + values[index - width] - values[index - width - 1];
+        }
+        if (x > 0) return values[index - 1];
+        if (z > 0) return values[index - width];
+        return 0;
+    }
+}
+
+// Heights are mapped to order-preserving integers and predicted from their
+// already-coded neighbours; the residuals of a smooth heightfield are small, so
+// zigzag + LEB128 varints store most samples in two or three bytes. Lossless.
+void ChunkCache::encodeHeights(const std::vector<float>& heights, std::vector<uint8_t>& out) {
+    out.clear();
+    out.reserve(PAYLOAD_HEADER + heights.size() * 3);
+
+    uint32_t count = static_cast<uint32_t>(heights.size());
+    out.resize(PAYLOAD_HEADER);
+    std::memcpy(out.data(), &count, 4);
+    out[4] = ENCODING_PREDICTED;
+
+    std::vector<uint32_t> values(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        values[i] = orderedBits(heights[i]);
+    }
+
+    uint32_t width = gridWidth(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        int64_t residual = static_cast<int64_t>(values[i]) - predict(values.data(), i, width);
+        uint64_t zigzag = (static_cast<uint64_t>(residual) << 1) ^ static_cast<uint64_t>(residual >> 63);
+        do {
+            uint8_t byte = zigzag & 0x7F;
+            zigzag >>= 7;
+            out.push_back(zigzag ? (byte | 0x80) : byte);
+        } while (zigzag);
+    }
+}
+
+bool ChunkCache::decodeHeights(const uint8_t* data, size_t size, std::pmr::vector<float>& heights) {
+    if (size < PAYLOAD_HEADER || data[4] != ENCODING_PREDICTED) return false;
+
+    uint32_t count = 0;
+    std::memcpy(&count, data, 4);
+    if (count > size - PAYLOAD_HEADER) return false;  // Every sample takes at least one byte
+
+    std::pmr::vector<uint32_t> values(count, heights.get_allocator().resource());
+    heights.resize(count);
+    uint32_t width = gridWidth(count);
+
+    size_t pos = PAYLOAD_HEADER;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint64_t zigzag = 0;
+        int shift = 0;
+        while (true) {
+            if (pos >= size || shift > 63) return false;
+            uint8_t byte = data[pos++];
+            zigzag |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+            shift += 7;
+        }
+
+        int64_t residual = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+        values[i] = static_cast<uint32_t>(predict(values.data(), i, width) + residual);
+        heights[i] = fromOrderedBits(values[i]);
+    }
+    return true;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "RegionFile.h"
+
+// On-disk cache of generated chunk heightfields, grouped into region files.
+// The directory is keyed by a hash of everything that shapes the terrain (seed,
+// noise configs, biome layout), so a config change never serves stale chunks.
+// Reads are synchronous and decode from the region mapping; writes are queued
+// and flushed by a background thread.
+class ChunkCache {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t writes = 0;
+        uint64_t rawBytes = 0;      // Uncompressed payload bytes written
+        uint64_t storedBytes = 0;   // Encoded payload bytes written
+    };
+
+    ChunkCache(const std::string& rootDirectory, uint64_t worldKey);
+    ~ChunkCache();
+
+    ChunkCache(const ChunkCache&) = delete;
+    ChunkCache& operator=(const ChunkCache&) = delete;
+
+    // Fills heights with the cached (SIZE + 1)^2 grid; false on a miss
+    bool load(int chunkX, int chunkZ, std::pmr::vector<float>& heights);
+    // Queues a heightfield for asynchronous write-back
+    void store(int chunkX, int chunkZ, std::vector<float> heights);
+    // Blocks until every queued write has reached disk
+    void flush();
+
+    Stats getStats() const;
+    uint64_t getWorldKey() const { return worldKey; }
+    const std::string& getDirectory() const { return directory; }
+
+    // Lossless float encoding used for payloads (exposed for tests)
+    static void encodeHeights(const std::vector<float>& heights, std::vector<uint8_t>& out);
+    // Temporaries come from the output vector's memory resource
+    static bool decodeHeights(const uint8_t* data, size_t size, std::pmr::vector<float>& heights);
+
+private:
+    struct PendingWrite {
+        int chunkX;
+        int chunkZ;
+        std::vector<float> heights;
+    };
+
+    RegionFile& regionFor(int chunkX, int chunkZ, int& localX, int& localZ);
+    void writerLoop();
+
+    std::string directory;
+    uint64_t worldKey;
+
+    std::mutex regionMutex;
+    std::unordered_map<uint64_t, std::unique_ptr<RegionFile>> regions;
+
+    std::mutex writeMutex;
+    std::condition_variable writeCondition;
+    std::condition_variable idleCondition;
+    std::queue<PendingWrite> pendingWrites;
+    bool writerBusy = false;
+    bool shouldStop = false;
+    std::thread writer;
+
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> writes{0};
+    std::atomic<uint64_t> rawBytes{0};
+    std::atomic<uint64_t> storedBytes{0};
+};
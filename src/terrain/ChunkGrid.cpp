@@ -0,0 +1,111 @@
+#include "ChunkGrid.h"
+#include <cstdlib>
+#include "Chunk.h"
+
+namespace {
+    // Euclidean modulo so negative chunk coordinates wrap correctly
+    int wrap(int value, int side) {
+        int m = value % side;
+        return m < 0 ? m + side : m;
+    }
+}
+
+ChunkGrid::ChunkGrid(int radius)
+    : radius(radius < 0 ? 0 : radius)
+    , side(2 * this->radius + 1)
+    , slots(static_cast<size_t>(side) * side)
+{
+}
+
+bool ChunkGrid::contains(int x, int z) const {
+    return std::abs(x - centerX) <= radius && std::abs(z - centerZ) <= radius;
+}
+
+size_t ChunkGrid::slotIndex(int x, int z) const {
+    return static_cast<size_t>(wrap(z, side)) * side + wrap(x, side);
+}
+
+std::shared_ptr<Chunk> ChunkGrid::get(int x, int z) const {
+    if (!contains(x, z)) return nullptr;
+
+    const Slot& slot = slots[slotIndex(x, z)];
+    if (slot.chunk && slot.x == x && slot.z == z) {
+        return slot.chunk;
+    }
+    return nullptr;
+}
+
+bool ChunkGrid::set(int x, int z, std::shared_ptr<Chunk> chunk) {
+    if (!contains(x, z)) return false;
+
+    Slot& slot = slots[slotIndex(x, z)];
+    if (!slot.chunk && chunk) ++count;
+    if (slot.chunk && !chunk) --count;
+
+    slot.x = x;
+    slot.z = z;
+    slot.chunk = std::move(chunk);
+    return true;
+}
+
+std::shared_ptr<Chunk> ChunkGrid::remove(int x, int z) {
+    if (!contains(x, z)) return nullptr;
+
+    Slot& slot = slots[slotIndex(x, z)];
+    if (!slot.chunk || slot.x != x || slot.z != z) return nullptr;
+
+    --count;
+    return std::move(slot.chunk);
+}
+
+void ChunkGrid::clear() {
+    for (auto& slot : slots) {
+        slot.chunk.reset();
+    }
+    count = 0;
+}
+
+void ChunkGrid::evictSlot(Slot& slot, const EvictFn& onEvict) {
+    if (!slot.chunk || contains(slot.x, slot.z)) return;
+
+    auto chunk = std::move(slot.chunk);
+    --count;
+    if (onEvict) {
+        onEvict(slot.x, slot.z, std::move(chunk));
+    }
+}
+
+void ChunkGrid::recenter(int x, int z, const EvictFn& onEvict) {
+    int dx = x - centerX;
+    int dz = z - centerZ;
+    if (dx == 0 && dz == 0) return;
+
+    int oldMinX = centerX - radius;
+    int oldMinZ = centerZ - radius;
+    centerX = x;
+    centerZ = z;
+
+    // Jumped further than the window is wide: everything leaves
+    if (std::abs(dx) >= side || std::abs(dz) >= side) {
+        for (auto& slot : slots) {
+            evictSlot(slot, onEvict);
+        }
+        return;
+    }
+
+    // Columns that scrolled out along X
+    for (int i = 0; i < std::abs(dx); ++i) {
+        int columnX = dx > 0 ? oldMinX + i : oldMinX + side - 1 - i;
+        for (int j = 0; j < side; ++j) {
+            evictSlot(slots[slotIndex(columnX, oldMinZ + j)], onEvict);
+        }
+    }
+
+    // Rows that scrolled out along Z (corners already handled above are empty)
+    for (int i = 0; i < std::abs(dz); ++i) {
+        int rowZ = dz > 0 ? oldMinZ + i : oldMinZ + side - 1 - i;
+        for (int j = 0; j < side; ++j) {
+            evictSlot(slots[slotIndex(oldMinX + j, rowZ)], onEvict);
+        }
+    }
+}
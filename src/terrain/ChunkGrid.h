@@ -0,0 +1,62 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+class Chunk;
+
+// Fixed-size toroidal window of resident chunks centered on the player.
+// A chunk at (x, z) lives in slot (x mod N, z mod N), so lookups are O(1),
+// neighbours are adjacent slots and iteration walks one contiguous array.
+// Moving the window only touches the rows/columns that scroll out of it.
+class ChunkGrid {
+public:
+    using EvictFn = std::function<void(int x, int z, std::shared_ptr<Chunk> chunk)>;
+
+    explicit ChunkGrid(int radius);
+
+    int getRadius() const { return radius; }
+    int getSide() const { return side; }
+    int getCenterX() const { return centerX; }
+    int getCenterZ() const { return centerZ; }
+    size_t size() const { return count; }
+
+    // True if (x, z) falls inside the current window
+    bool contains(int x, int z) const;
+
+    std::shared_ptr<Chunk> get(int x, int z) const;
+    bool set(int x, int z, std::shared_ptr<Chunk> chunk);
+    std::shared_ptr<Chunk> remove(int x, int z);
+    void clear();
+
+    // Move the window; chunks that leave it are handed to onEvict
+    void recenter(int x, int z, const EvictFn& onEvict);
+
+    // Visit occupied slots in memory order
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& slot : slots) {
+            if (slot.chunk) {
+                fn(slot.x, slot.z, slot.chunk);
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        int x = 0;
+        int z = 0;
+        std::shared_ptr<Chunk> chunk;
+    };
+
+    size_t slotIndex(int x, int z) const;
+    void evictSlot(Slot& slot, const EvictFn& onEvict);
+
+    int radius;
+    int side;
+    int centerX = 0;
+    int centerZ = 0;
+    size_t count = 0;
+    std::vector<Slot> slots;
+};
@@ -1,82 +1,197 @@
 #include "ChunkManager.h"
 #include "ChunkConstants.h"
 #include "Debug.h"
+#include "MemoryTracker.h"
 #include "Terrain.h"
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 
-ChunkManager::ChunkManager(TerrainThreadPool& threadPool, size_t maxChunks)
-    : maxLoadedChunks(maxChunks)
+ChunkManager::ChunkManager(TerrainThreadPool& threadPool, size_t memoryBudgetBytes, int ringRadius)
+    : chunkGrid(ringRadius)
+    , memoryBudgetBytes(memoryBudgetBytes)
     , threadPool(threadPool)
 {
-    Debug::log("ChunkManager initialized with " + std::to_string(maxChunks) + " max chunks");
+    Debug::log("ChunkManager initialized with a " + std::to_string(memoryBudgetBytes >> 20) + " MB budget, ring side " +
+               std::to_string(chunkGrid.getSide()));
+}
+
+size_t ChunkManager::getResidentBytes() const {
+    size_t total = 0;
+    forEachChunk([&total](int, int, const std::shared_ptr<Chunk>& chunk) {
+        total += chunk->getMemoryBytes();
+    });
+    return total;
+}
+
+size_t ChunkManager::getAverageChunkBytes() {
+    // CPU and GPU averaged separately: freshly generated chunks have not been uploaded yet
+    const MemoryTracker& tracker = MemoryTracker::getInstance();
+    size_t cpuChunks = tracker.getObjectCount(MemoryCategory::ChunkCpu);
+    if (cpuChunks == 0) {
+        return Chunk::estimateMemoryBytes();
+    }
+    size_t average = tracker.getBytes(MemoryCategory::ChunkCpu) / cpuChunks;
+    if (size_t gpuChunks = tracker.getObjectCount(MemoryCategory::ChunkGpu)) {
+        average += tracker.getBytes(MemoryCategory::ChunkGpu) / gpuChunks;
+    }
+    return average;
+}
+
+std::shared_ptr<Chunk> ChunkManager::findChunk(int x, int z) const {
+    if (auto chunk = chunkGrid.get(x, z)) {
+        return chunk;
+    }
+    auto it = pinnedChunks.find({x, z});
+    return it != pinnedChunks.end() ? it->second : nullptr;
 }
 
 std::shared_ptr<Chunk> ChunkManager::getChunk(int x, int z) {
     ChunkCoord coord{x, z};
-    auto it = loadedChunks.find(coord);
-    if (it != loadedChunks.end()) {
+    if (auto chunk = chunkGrid.get(x, z)) {
         updateLRU(coord);
-        return it->second;
+        return chunk;
+    }
+
+    auto it = pinnedChunks.find(coord);
+    if (it != pinnedChunks.end()) {
+        auto chunk = it->second;
+        // The ring has moved back over this chunk; migrate it out of the fallback map
+        if (chunkGrid.set(x, z, chunk)) {
+            pinnedChunks.erase(it);
+        }
+        updateLRU(coord);
+        return chunk;
     }
     return nullptr;
 }
 
-void ChunkManager::loadChunk(int x, int z, std::shared_ptr<Terrain> terrain) {
+std::shared_ptr<Chunk> ChunkManager::getNeighbor(int x, int z, int dx, int dz) const {
+    return findChunk(x + dx, z + dz);
+}
+
+void ChunkManager::adoptChunk(int x, int z, std::shared_ptr<Chunk> chunk) {
+    if (!chunk || findChunk(x, z)) return;
+
+    if (!chunkGrid.set(x, z, chunk)) {
+        pinnedChunks[{x, z}] = std::move(chunk);
+    }
+    updateLRU({x, z});
+}
+
+bool ChunkManager::loadChunk(int x, int z, const std::shared_ptr<Terrain>& terrain) {
+    if (tryLoadChunk(x, z, terrain)) return true;
+    noteMissing({x, z});
+    return false;
+}
+
+bool ChunkManager::tryLoadChunk(int x, int z, const std::shared_ptr<Terrain>& terrain) {
     ChunkCoord coord{x, z};
     
     // Check if already loaded
-    if (loadedChunks.find(coord) != loadedChunks.end()) {
-        Debug::log("[ChunkManager] Chunk already loaded at (" + std::to_string(x) + ", " + std::to_string(z) + ")");
+    if (findChunk(x, z)) {
+        DEBUG_LOG_VERBOSE("[ChunkManager] Chunk already loaded at (" + std::to_string(x) + ", " + std::to_string(z) + ")");
         updateLRU(coord);
-        return;
+        return true;
     }
     
-    // Enforce memory limits
-    while (loadedChunks.size() >= maxLoadedChunks) {
-        Debug::log("[ChunkManager] Max chunks reached, unloading least recently used chunk");
-        unloadLeastRecentlyUsed();
+    // Enforce the memory budget, counting the chunk about to be created
+    if (!makeRoomForChunk()) {
+        DEBUG_LOG_VERBOSE("[ChunkManager] Memory budget full of chunks in view, deferring (" + std::to_string(x) + ", " +
+                          std::to_string(z) + ")");
+        return false;
     }
     
     try {
         if (!terrain || !terrain->chunkFactory) {
             Debug::logError("[ChunkManager] Invalid terrain or chunk factory");
-            return;
+            return false;
         }
         
-        // Create the chunk but don't generate it yet
+        // Construction is cheap; generation happens once on a worker
         auto chunk = terrain->chunkFactory->createChunk(x, z, terrain);
         if (chunk) {
-            loadedChunks[coord] = chunk;
+            if (!chunkGrid.set(x, z, chunk)) {
+                pinnedChunks[coord] = chunk;
+            }
             updateLRU(coord);
+            lastDelta.loaded.push_back(coord);
             
             // Queue the chunk for async generation
           //  Debug::log("[ChunkManager] Created chunk at (" + std::to_string(x) + ", " + std::to_string(z) + "), queueing for generation");
-            threadPool.queueChunkUpdate(x, z, terrain);
+            threadPool.queueChunkGeneration(chunk);
+            return true;
         }
     } catch (const std::exception& e) {
      //   Debug::logError("[ChunkManager] Failed to load chunk: " + std::string(e.what()));
     }
+    return false;
+}
+
+bool ChunkManager::makeRoomForChunk() {
+    const size_t chunkBytes = getAverageChunkBytes();
+    size_t skipped = 0;
+    while (!lruOrder.empty() && (getLoadedChunkCount() + 1) * chunkBytes > memoryBudgetBytes) {
+        // Every remaining chunk is in view: evicting one would only open a hole under the player
+        if (skipped >= lruOrder.size()) return false;
+
+        ChunkCoord oldest = lruOrder.front();
+        if (streamTracker.isInView(oldest.x, oldest.z)) {
+            // Still in use; rotating it to the back keeps the scan from revisiting it
+            lruOrder.splice(lruOrder.end(), lruOrder, lruOrder.begin());
+            ++skipped;
+            continue;
+        }
+        DEBUG_LOG_VERBOSE("[ChunkManager] Memory budget reached, unloading least recently used chunk");
+        unloadChunk(oldest.x, oldest.z);
+    }
+    return true;
+}
+
+void ChunkManager::noteMissing(const ChunkCoord& coord) {
+    if (!streamTracker.isInView(coord.x, coord.z)) return;
+    if (std::find(missingInView.begin(), missingInView.end(), coord) == missingInView.end()) {
+        missingInView.push_back(coord);
+    }
 }
 
 void ChunkManager::unloadChunk(int x, int z) {
     ChunkCoord coord{x, z};
-    auto it = loadedChunks.find(coord);
-    if (it != loadedChunks.end()) {
-    //    Debug::log("[ChunkManager] Unloading chunk at (" + std::to_string(x) + ", " + std::to_string(z) + ")");
-        loadedChunks.erase(it);
-        
-        // Remove from LRU if present
-        auto lruIt = std::find(lruOrder.begin(), lruOrder.end(), coord);
-        if (lruIt != lruOrder.end()) {
-            lruOrder.erase(lruIt);
+    std::shared_ptr<Chunk> removed = chunkGrid.remove(x, z);
+    if (!removed) {
+        auto pinned = pinnedChunks.find(coord);
+        if (pinned != pinnedChunks.end()) {
+            removed = std::move(pinned->second);
+            pinnedChunks.erase(pinned);
         }
     }
+    if (removed) {
+        // A queued generation or pending upload for this chunk becomes a no-op
+        removed->markUnloaded();
+        if (unloadCallback) {
+            unloadCallback(*removed);
+        }
+        if (auto terrain = terrainRef.lock(); terrain && terrain->chunkFactory) {
+            terrain->chunkFactory->releaseChunk(removed);
+        }
+    //    Debug::log("[ChunkManager] Unloading chunk at (" + std::to_string(x) + ", " + std::to_string(z) + ")");
+        lastDelta.unloaded.push_back(coord);
+    }
+
+    // Remove from LRU if present; both nodes are kept for the next load instead of freed
+    auto lruIt = lruIndex.find(coord);
+    if (lruIt != lruIndex.end()) {
+        lruSpare.splice(lruSpare.end(), lruOrder, lruIt->second);
+        lruSpareIndexNodes.push_back(lruIndex.extract(lruIt));
+    }
 }
 
 void ChunkManager::updateLoadedChunks(const glm::vec3& playerPos, float viewDistance) {
-    int playerChunkX = static_cast<int>(playerPos.x) / ChunkConstants::SIZE;
-    int playerChunkZ = static_cast<int>(playerPos.z) / ChunkConstants::SIZE;
+    int playerChunkX = static_cast<int>(std::floor(playerPos.x / ChunkConstants::SIZE));
+    int playerChunkZ = static_cast<int>(std::floor(playerPos.z / ChunkConstants::SIZE));
     float chunkViewDistance = viewDistance / ChunkConstants::SIZE;
+    lastDelta.loaded.clear();
+    lastDelta.unloaded.clear();
     
     // Get terrain pointer
     auto terrain = terrainRef.lock();
@@ -84,94 +199,87 @@ void ChunkManager::updateLoadedChunks(const glm::vec3& playerPos, float viewDist
         Debug::logError("[ChunkManager] No valid terrain reference");
         return;
     }
-    
-    // First, ensure immediate chunks around player are loaded
-    for (int z = -1; z <= 1; ++z) {
-        for (int x = -1; x <= 1; ++x) {
-            int chunkX = playerChunkX + x;
-            int chunkZ = playerChunkZ + z;
-            
-            if (!getChunk(chunkX, chunkZ)) {
-                loadChunk(chunkX, chunkZ, terrain);
-            }
+
+    // Scroll the ring with the player; chunks leaving it stay resident as pinned until unloaded
+    chunkGrid.recenter(playerChunkX, playerChunkZ, [this](int x, int z, std::shared_ptr<Chunk> chunk) {
+        pinnedChunks[{x, z}] = std::move(chunk);
+    });
+
+    // Only the strips of the view disk that changed since the last update
+    streamTracker.update(playerChunkX, playerChunkZ, chunkViewDistance, streamDelta);
+
+    // Retry in-view chunks that missed earlier updates before the new rim; the budget
+    // does not change within an update, so the first miss defers everything after it
+    bool budgetFull = false;
+    size_t stillMissing = 0;
+    for (const ChunkCoord& coord : missingInView) {
+        if (!streamTracker.isInView(coord.x, coord.z) || findChunk(coord.x, coord.z)) continue;
+        if (budgetFull || !tryLoadChunk(coord.x, coord.z, terrain)) {
+            budgetFull = true;
+            missingInView[stillMissing++] = coord;
         }
     }
-    
-    // Then handle the rest of the view distance
-    int radius = static_cast<int>(chunkViewDistance);
-    for (int r = 2; r <= radius; ++r) {
-        for (int x = -r; x <= r; ++x) {
-            for (int z = -r; z <= r; ++z) {
-                // Only process chunks at current radius
-                if (std::max(std::abs(x), std::abs(z)) != r) continue;
-                
-                int chunkX = playerChunkX + x;
-                int chunkZ = playerChunkZ + z;
-                
-                // Check if chunk should be loaded
-                float dx = static_cast<float>(x);
-                float dz = static_cast<float>(z);
-                if (dx * dx + dz * dz <= chunkViewDistance * chunkViewDistance) {
-                    if (!getChunk(chunkX, chunkZ)) {
-                        loadChunk(chunkX, chunkZ, terrain);
-                    }
-                }
-            }
+    missingInView.resize(stillMissing);
+
+    // Entering chunks arrive nearest first, so the 3x3 around the player loads before the rim
+    for (const auto& [chunkX, chunkZ] : streamDelta.entering) {
+        if (findChunk(chunkX, chunkZ)) continue;
+        if (budgetFull || !tryLoadChunk(chunkX, chunkZ, terrain)) {
+            budgetFull = true;
+            noteMissing({chunkX, chunkZ});
         }
     }
-    
-    // Collect chunks to unload
-    std::vector<ChunkCoord> chunksToUnload;
-    for (const auto& [coord, chunk] : loadedChunks) {
-        float dx = static_cast<float>(coord.x - playerChunkX);
-        float dz = static_cast<float>(coord.z - playerChunkZ);
-        float distanceSquared = dx * dx + dz * dz;
-        
-        if (distanceSquared > chunkViewDistance * chunkViewDistance) {
-            chunksToUnload.push_back(coord);
-        }
+
+    for (const auto& [chunkX, chunkZ] : streamDelta.leaving) {
+        pendingUnloads.push_back({chunkX, chunkZ});
     }
-    
-    // Rate limit: unload at most 4 chunks per update
+    if (pendingUnloads.empty()) return;
+
+    // Drop anything that came back into view or is already gone
+    pendingUnloads.erase(std::remove_if(pendingUnloads.begin(), pendingUnloads.end(),
+        [this](const ChunkCoord& c) {
+            return streamTracker.isInView(c.x, c.z) || !findChunk(c.x, c.z);
+        }), pendingUnloads.end());
+
+    // Rate limit: unload at most 4 chunks per update, furthest first
     const size_t maxUnloadsPerUpdate = 4;
-    size_t unloadCount = 0;
-    
-    // Sort by distance for priority unloading
-    std::sort(chunksToUnload.begin(), chunksToUnload.end(),
-        [playerChunkX, playerChunkZ](const ChunkCoord& a, const ChunkCoord& b) {
-            float distA = std::pow(a.x - playerChunkX, 2) + std::pow(a.z - playerChunkZ, 2);
-            float distB = std::pow(b.x - playerChunkX, 2) + std::pow(b.z - playerChunkZ, 2);
-            return distA > distB; // Unload furthest chunks first
-        });
-    
-    for (const auto& coord : chunksToUnload) {
-        if (unloadCount >= maxUnloadsPerUpdate) break;
-        unloadChunk(coord.x, coord.z);
-        unloadCount++;
-    }
-}
+    auto distanceSq = [playerChunkX, playerChunkZ](const ChunkCoord& c) {
+        int dx = c.x - playerChunkX;
+        int dz = c.z - playerChunkZ;
+        return dx * dx + dz * dz;
+    };
+    size_t unloadCount = std::min(maxUnloadsPerUpdate, pendingUnloads.size());
+    std::partial_sort(pendingUnloads.begin(), pendingUnloads.begin() + unloadCount, pendingUnloads.end(),
+        [&](const ChunkCoord& a, const ChunkCoord& b) { return distanceSq(a) > distanceSq(b); });
 
-void ChunkManager::unloadLeastRecentlyUsed() {
-    if (!lruOrder.empty()) {
-        const auto& lruChunk = lruOrder.front();
-       // Debug::log("[ChunkManager] Unloading LRU chunk at (" + std::to_string(lruChunk.x) + ", " + std::to_string(lruChunk.z) + ")");
-        unloadChunk(lruChunk.x, lruChunk.z);
-        lruOrder.pop_front();
+    for (size_t i = 0; i < unloadCount; ++i) {
+        unloadChunk(pendingUnloads[i].x, pendingUnloads[i].z);
     }
+    pendingUnloads.erase(pendingUnloads.begin(), pendingUnloads.begin() + unloadCount);
 }
 
 void ChunkManager::updateLRU(const ChunkCoord& coord) {
-    // Remove if already in LRU
-    auto it = std::find(lruOrder.begin(), lruOrder.end(), coord);
-    if (it != lruOrder.end()) {
-        lruOrder.erase(it);
+    // Move to back (most recently used) in O(1)
+    auto it = lruIndex.find(coord);
+    if (it != lruIndex.end()) {
+        lruOrder.splice(lruOrder.end(), lruOrder, it->second);
+        return;
     }
-    
-    // Add to back (most recently used)
-    lruOrder.push_back(coord);
-    
-    // Trim if too large
-    while (lruOrder.size() > maxLoadedChunks) {
-        lruOrder.pop_front();
+
+    // Every resident chunk has exactly one entry; unloadChunk removes it
+    if (!lruSpare.empty()) {
+        lruOrder.splice(lruOrder.end(), lruSpare, lruSpare.begin());
+        lruOrder.back() = coord;
+    } else {
+        lruOrder.push_back(coord);
     }
-} 
\ No newline at end of file
+    if (!lruSpareIndexNodes.empty()) {
+        auto node = std::move(lruSpareIndexNodes.back());
+        lruSpareIndexNodes.pop_back();
+        node.key() = coord;
+        node.mapped() = std::prev(lruOrder.end());
+        lruIndex.insert(std::move(node));
+    } else {
+        lruIndex[coord] = std::prev(lruOrder.end());
+    }
+}
@@ -3,9 +3,16 @@
 #include <unordered_map>
 #include <memory>
 #include <list>
+#include <cstdint>
+#include <functional>
+#include <vector>
 #include <glm/glm.hpp>
 #include "Chunk.h"
+#include "ChunkHash.h"
+#include "ChunkGrid.h"
+#include "ChunkStreamTracker.h"
 #include "IChunkFactory.h"
+#include "TerrainConstants.h"
 #include "TerrainThreadPool.h"
 
 // Forward declare Terrain instead of including it
@@ -22,32 +29,88 @@ public:
     };
     
     struct ChunkCoordHash {
-        std::size_t operator()(const ChunkCoord& coord) const {
-            return std::hash<int>()(coord.x) ^ (std::hash<int>()(coord.z) << 1);
-        }
+        std::size_t operator()(const ChunkCoord& coord) const { return hashChunkCoord(coord.x, coord.z); }
+    };
+
+    // Chunks actually loaded/unloaded during the last updateLoadedChunks call
+    struct UpdateDelta {
+        std::vector<ChunkCoord> loaded;
+        std::vector<ChunkCoord> unloaded;
     };
 
-    explicit ChunkManager(TerrainThreadPool& threadPool, size_t maxChunks = 512);
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 64ull << 20;  // Roughly 640 uploaded chunks
+
+    explicit ChunkManager(TerrainThreadPool& threadPool, size_t memoryBudgetBytes = DEFAULT_MEMORY_BUDGET,
+                          int ringRadius = TerrainConstants::VIEW_DISTANCE + 1);
     
     std::shared_ptr<Chunk> getChunk(int x, int z);
-    void loadChunk(int x, int z, std::shared_ptr<Terrain> terrain);
+    // False if the chunk is not resident afterwards (budget full of in-view chunks, or creation failed);
+    // in-view coordinates that miss are retried by every later updateLoadedChunks
+    bool loadChunk(int x, int z, const std::shared_ptr<Terrain>& terrain);
+    void adoptChunk(int x, int z, std::shared_ptr<Chunk> chunk);
     void unloadChunk(int x, int z);
     void updateLoadedChunks(const glm::vec3& playerPos, float viewDistance);
+    const UpdateDelta& getLastUpdateDelta() const { return lastDelta; }
+
+    // Resident lookup (ring, then pinned) without touching LRU order
+    std::shared_ptr<Chunk> findChunk(int x, int z) const;
+    // O(1) lookup of an edge neighbour (dx/dz in -1..1) without touching LRU order
+    std::shared_ptr<Chunk> getNeighbor(int x, int z, int dx, int dz) const;
+
+    // Visit every resident chunk: ring slots in memory order, then pinned chunks
+    template <typename Fn>
+    void forEachChunk(Fn&& fn) const {
+        chunkGrid.forEach(fn);
+        for (const auto& [coord, chunk] : pinnedChunks) {
+            fn(coord.x, coord.z, chunk);
+        }
+    }
     
     // Set the terrain reference
     void setTerrain(std::shared_ptr<Terrain> terrain) { terrainRef = terrain; }
+
+    // Called on the main thread for every chunk leaving residency, so render-side
+    // resources that follow the chunk (grass instances) are released with it
+    void setUnloadCallback(std::function<void(Chunk&)> callback) { unloadCallback = std::move(callback); }
     
     // Debug/stats
-    size_t getLoadedChunkCount() const { return loadedChunks.size(); }
-    size_t getMaxChunks() const { return maxLoadedChunks; }
+    size_t getLoadedChunkCount() const { return chunkGrid.size() + pinnedChunks.size(); }
+    size_t getPinnedChunkCount() const { return pinnedChunks.size(); }
+    // In-view chunks waiting for a retry; streaming should keep updating while this is true
+    bool hasMissingChunks() const { return !missingInView.empty(); }
+
+    // Residency is limited by bytes: loading evicts LRU chunks while
+    // (resident + 1) * average chunk footprint would exceed the budget.
+    // Chunks inside the view disk are never evicted; a load that finds only
+    // those waits in the missing list instead.
+    void setMemoryBudget(size_t bytes) { memoryBudgetBytes = bytes; }
+    size_t getMemoryBudget() const { return memoryBudgetBytes; }
+    // Measured CPU + GPU bytes of resident chunks (walks them; meant for stats, not per load)
+    size_t getResidentBytes() const;
+    // Live average from the MemoryTracker; falls back to Chunk::estimateMemoryBytes()
+    static size_t getAverageChunkBytes();
 
 private:
-    void unloadLeastRecentlyUsed();
+    bool tryLoadChunk(int x, int z, const std::shared_ptr<Terrain>& terrain);
+    // Evicts least recently used chunks outside the view disk until one more chunk fits
+    bool makeRoomForChunk();
+    void noteMissing(const ChunkCoord& coord);
     void updateLRU(const ChunkCoord& coord);
 
-    std::unordered_map<ChunkCoord, std::shared_ptr<Chunk>, ChunkCoordHash> loadedChunks;
+    ChunkGrid chunkGrid;  // Resident chunks around the player
+    std::unordered_map<ChunkCoord, std::shared_ptr<Chunk>, ChunkCoordHash> pinnedChunks;  // Chunks outside the ring
     std::list<ChunkCoord> lruOrder;  // Front = least recently used, Back = most recently used
-    size_t maxLoadedChunks;
+    std::unordered_map<ChunkCoord, std::list<ChunkCoord>::iterator, ChunkCoordHash> lruIndex;
+    // Recycled LRU nodes, so streaming in steady state doesn't allocate
+    std::list<ChunkCoord> lruSpare;
+    std::vector<decltype(lruIndex)::node_type> lruSpareIndexNodes;
+    ChunkStreamTracker streamTracker;
+    ChunkStreamTracker::Delta streamDelta;
+    std::vector<ChunkCoord> pendingUnloads;  // Left the view disk, waiting for the unload rate limit
+    std::vector<ChunkCoord> missingInView;   // In the view disk but not resident; retried every update
+    UpdateDelta lastDelta;
+    size_t memoryBudgetBytes;
     TerrainThreadPool& threadPool;
     std::weak_ptr<Terrain> terrainRef; // Store a weak_ptr to avoid circular reference
+    std::function<void(Chunk&)> unloadCallback;
 }; 
\ No newline at end of file
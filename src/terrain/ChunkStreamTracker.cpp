@@ -0,0 +1,100 @@
+#include "ChunkStreamTracker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+bool ChunkStreamTracker::Disk::rowSpan(int z, int& minX, int& maxX) const {
+    int dz = std::abs(z - centerZ);
+    if (dz > rows()) return false;
+
+    minX = centerX - halfWidths[dz];
+    maxX = centerX + halfWidths[dz];
+    return true;
+}
+
+void ChunkStreamTracker::buildHalfWidths(float radius, std::vector<int>& out) {
+    out.clear();
+    if (radius < 0.0f) return;
+
+    // Same membership test as before: dx * dx + dz * dz <= radius * radius
+    float radiusSq = radius * radius;
+    int rows = static_cast<int>(std::floor(radius));
+    out.reserve(rows + 1);
+    for (int dz = 0; dz <= rows; ++dz) {
+        int width = static_cast<int>(std::floor(std::sqrt(radiusSq - static_cast<float>(dz * dz))));
+        while (width > 0 && static_cast<float>(width * width + dz * dz) > radiusSq) --width;
+        while (static_cast<float>((width + 1) * (width + 1) + dz * dz) <= radiusSq) ++width;
+        out.push_back(width);
+    }
+}
+
+void ChunkStreamTracker::appendDifference(int z, int minA, int maxA, bool hasA, int minB, int maxB, bool hasB,
+                                          std::vector<std::pair<int, int>>& out) {
+    // Cells of row z in interval A that are not in interval B
+    if (!hasA) return;
+    if (!hasB || maxB < minA || minB > maxA) {
+        for (int x = minA; x <= maxA; ++x) out.emplace_back(x, z);
+        return;
+    }
+    for (int x = minA; x < minB; ++x) out.emplace_back(x, z);
+    for (int x = maxB + 1; x <= maxA; ++x) out.emplace_back(x, z);
+}
+
+void ChunkStreamTracker::update(int centerX, int centerZ, float radius, Delta& delta) {
+    delta.clear();
+    if (active && centerX == current.centerX && centerZ == current.centerZ && radius == currentRadius) {
+        return;
+    }
+
+    bool hadView = active;
+    previous = current;
+    current.centerX = centerX;
+    current.centerZ = centerZ;
+    if (radius != currentRadius) {
+        buildHalfWidths(radius, current.halfWidths);
+        currentRadius = radius;
+    }
+    active = true;
+
+    // Rows covered by the new disk: diff against the old disk row by row
+    for (int z = centerZ - current.rows(); z <= centerZ + current.rows(); ++z) {
+        int newMin = 0, newMax = -1, oldMin = 0, oldMax = -1;
+        bool hasNew = current.rowSpan(z, newMin, newMax);
+        bool hasOld = hadView && previous.rowSpan(z, oldMin, oldMax);
+        appendDifference(z, newMin, newMax, hasNew, oldMin, oldMax, hasOld, delta.entering);
+        appendDifference(z, oldMin, oldMax, hasOld, newMin, newMax, hasNew, delta.leaving);
+    }
+
+    // Rows only the old disk covered leave entirely
+    if (hadView) {
+        for (int z = previous.centerZ - previous.rows(); z <= previous.centerZ + previous.rows(); ++z) {
+            if (std::abs(z - centerZ) <= current.rows()) continue;
+            int oldMin = 0, oldMax = -1;
+            if (previous.rowSpan(z, oldMin, oldMax)) {
+                appendDifference(z, oldMin, oldMax, true, 0, -1, false, delta.leaving);
+            }
+        }
+    }
+
+    auto distanceSq = [centerX, centerZ](const std::pair<int, int>& c) {
+        int dx = c.first - centerX;
+        int dz = c.second - centerZ;
+        return dx * dx + dz * dz;
+    };
+    std::sort(delta.entering.begin(), delta.entering.end(),
+        [&](const auto& a, const auto& b) { return distanceSq(a) < distanceSq(b); });
+    std::sort(delta.leaving.begin(), delta.leaving.end(),
+        [&](const auto& a, const auto& b) { return distanceSq(a) > distanceSq(b); });
+}
+
+bool ChunkStreamTracker::isInView(int x, int z) const {
+    int minX = 0, maxX = -1;
+    return active && current.rowSpan(z, minX, maxX) && x >= minX && x <= maxX;
+}
+
+void ChunkStreamTracker::reset() {
+    active = false;
+    currentRadius = -1.0f;
+    current = Disk{};
+    previous = Disk{};
+}
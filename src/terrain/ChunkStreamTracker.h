@@ -0,0 +1,49 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+// Tracks the disk of chunk coordinates in view of the player and reports only
+// the coordinates that enter or leave it when the player changes chunk. Each
+// row of the disk is an interval, so a move costs O(rows + changed chunks)
+// instead of a rescan of the whole view area.
+class ChunkStreamTracker {
+public:
+    struct Delta {
+        std::vector<std::pair<int, int>> entering;  // Sorted nearest first
+        std::vector<std::pair<int, int>> leaving;   // Sorted furthest first
+
+        void clear() {
+            entering.clear();
+            leaving.clear();
+        }
+    };
+
+    // Move the view disk to (centerX, centerZ) with the given radius in chunks
+    // and write the entering/leaving coordinates into delta (cleared first).
+    void update(int centerX, int centerZ, float radius, Delta& delta);
+
+    bool isInView(int x, int z) const;
+    bool hasView() const { return active; }
+    void reset();
+
+private:
+    struct Disk {
+        int centerX = 0;
+        int centerZ = 0;
+        std::vector<int> halfWidths;  // Indexed by |dz|
+
+        int rows() const { return static_cast<int>(halfWidths.size()) - 1; }
+        // Inclusive X interval covered at world row z; false if the row is outside the disk
+        bool rowSpan(int z, int& minX, int& maxX) const;
+    };
+
+    static void buildHalfWidths(float radius, std::vector<int>& out);
+    static void appendDifference(int z, int minA, int maxA, bool hasA, int minB, int maxB, bool hasB,
+                                 std::vector<std::pair<int, int>>& out);
+
+    Disk current;
+    Disk previous;
+    float currentRadius = -1.0f;
+    bool active = false;
+};
@@ -1,7 +1,44 @@
 #include "GrassRenderer.h"
 #include "Shader.h" // Your existing shader class
+#include "Chunk.h"
 #include <glad/glad.h>
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include "Debug.h"
+
+namespace {
+    constexpr GLsizei CULLED_VERTEX_BYTES = 5 * sizeof(float);  // vec4 bladeBase + float bladeCorner
+
+    // The cull program has a geometry stage and captured varyings, which Shader doesn't cover
+    GLuint compileStage(GLenum type, const char* path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            Debug::logError(std::string("[GrassRenderer] Unable to read ") + path);
+            return 0;
+        }
+        std::stringstream source;
+        source << file.rdbuf();
+        std::string code = source.str();
+        const char* text = code.c_str();
+
+        GLuint stage = glCreateShader(type);
+        glShaderSource(stage, 1, &text, nullptr);
+        glCompileShader(stage);
+        GLint compiled = GL_FALSE;
+        glGetShaderiv(stage, GL_COMPILE_STATUS, &compiled);
+        if (!compiled) {
+            char log[1024] = {};
+            glGetShaderInfoLog(stage, sizeof(log), nullptr, log);
+            Debug::logError(std::string("[GrassRenderer] ") + path + ": " + log);
+            glDeleteShader(stage);
+            return 0;
+        }
+        return stage;
+    }
+}
 
 GrassRenderer::GrassRenderer() : VAO(0), VBO(0), instanceVBO(0) {}
 
@@ -9,11 +46,20 @@ GrassRenderer::~GrassRenderer() {
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
     glDeleteBuffers(1, &instanceVBO);
+    if (cullProgram != 0) {
+        glDeleteProgram(cullProgram);
+        glDeleteVertexArrays(1, &cullVAO);
+        glDeleteVertexArrays(2, culledVAO);
+        glDeleteBuffers(2, culledVBO);
+        if (transformFeedback != 0) glDeleteTransformFeedbacks(1, &transformFeedback);
+        glDeleteQueries(2, primitiveQueries);
+    }
 }
 
 void GrassRenderer::initialize() {
     shader = std::make_unique<Shader>("shaders/grass.vert", "shaders/grass.frag");
     setupBlade();
+    setupCulling();
 }
 
 void GrassRenderer::setupBlade() {
@@ -47,25 +93,290 @@ float triangle[] = {
     glBindVertexArray(0);                 // 💡 reset VAO binding
 }
 
-void GrassRenderer::update(const std::vector<glm::vec3>& newPositions) {
-    grassPositions = newPositions;
-    updateInstanceBuffer();
+int GrassRenderer::allocateSlot() {
+    if (!freeSlots.empty()) {
+        int slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+    if (slotHighWater == slotCapacity) {
+        growInstanceBuffer(slotHighWater + 1);
+    }
+    return slotHighWater++;
 }
 
-void GrassRenderer::updateInstanceBuffer() {
+void GrassRenderer::growInstanceBuffer(int minSlots) {
+    int newCapacity = std::max({minSlots, slotCapacity * 2, 64});
+    const GLsizeiptr slotBytes = SLOT_INSTANCES * sizeof(glm::vec3);
+
+    // Copy on the GPU so resident chunks don't need re-sending
+    GLuint newBuffer = 0;
+    glGenBuffers(1, &newBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, newCapacity * slotBytes, nullptr, GL_DYNAMIC_DRAW);
+    if (slotHighWater > 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, instanceVBO);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, slotHighWater * slotBytes);
+    }
+    glDeleteBuffers(1, &instanceVBO);
+    instanceVBO = newBuffer;
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    if (cullProgram != 0) {
+        glBindVertexArray(cullVAO);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+        // Worst case every blade survives: three captured vertices each
+        for (int i = 0; i < 2 && culledVBO[i] != 0; ++i) {
+            glBindBuffer(GL_ARRAY_BUFFER, culledVBO[i]);
+            glBufferData(GL_ARRAY_BUFFER,
+                         static_cast<GLsizeiptr>(newCapacity) * SLOT_INSTANCES * 3 * CULLED_VERTEX_BYTES, nullptr,
+                         GL_DYNAMIC_COPY);
+            captured[i] = false;  // Respecified storage: earlier captures are gone
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    slotCapacity = newCapacity;
+    gpuBytes.set(static_cast<size_t>(slotCapacity) * slotBytes);
+}
+
+void GrassRenderer::writeSlot(int slot, const glm::vec3* positions, size_t count) {
+    const GLintptr offset = static_cast<GLintptr>(slot) * SLOT_INSTANCES * sizeof(glm::vec3);
+    const GLsizeiptr bytes = SLOT_INSTANCES * sizeof(glm::vec3);
+    const glm::vec3 sentinel(0.0f, SENTINEL_Y, 0.0f);
+
+    // Invalidating the range lets the driver hand back fresh memory instead of waiting on draws
     glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
-    glBufferData(GL_ARRAY_BUFFER, grassPositions.size() * sizeof(glm::vec3),
-                 grassPositions.data(), GL_DYNAMIC_DRAW);
+    auto* mapped = static_cast<glm::vec3*>(
+        glMapBufferRange(GL_ARRAY_BUFFER, offset, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT));
+    if (mapped) {
+        std::copy(positions, positions + count, mapped);
+        std::fill(mapped + count, mapped + SLOT_INSTANCES, sentinel);
+        if (glUnmapBuffer(GL_ARRAY_BUFFER)) {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            return;
+        }
+        Debug::logError("[GrassRenderer] Instance buffer contents lost while mapped; rewriting range");
+    }
+
+    std::vector<glm::vec3> padded(positions, positions + count);
+    padded.resize(SLOT_INSTANCES, sentinel);
+    glBufferSubData(GL_ARRAY_BUFFER, offset, bytes, padded.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GrassRenderer::setSlotCount(int slot, size_t count) {
+    if (slotCounts.size() <= static_cast<size_t>(slot)) {
+        slotCounts.resize(slot + 1, 0);
+    }
+    instanceCount = instanceCount - std::max(slotCounts[slot], 0) + count;
+    slotCounts[slot] = static_cast<int>(count);
+}
+
+int GrassRenderer::addRange(const std::vector<glm::vec3>& positions) {
+    size_t count = std::min(positions.size(), static_cast<size_t>(SLOT_INSTANCES));
+    int slot = allocateSlot();
+    writeSlot(slot, positions.data(), count);
+    setSlotCount(slot, count);
+    ++slotsInUse;
+    return slot;
+}
+
+int GrassRenderer::addRange(std::vector<glm::vec3>&& positions) {
+    std::vector<glm::vec3> owned = std::move(positions);
+    size_t count = std::min(owned.size(), static_cast<size_t>(SLOT_INSTANCES));
+    int slot = allocateSlot();
+    writeSlot(slot, owned.data(), count);  // Pads with sentinels in the mapped range, not in the vector
+    setSlotCount(slot, count);
+    ++slotsInUse;
+    return slot;
+}
+
+bool GrassRenderer::isLiveRange(int range) const {
+    return range >= 0 && range < static_cast<int>(slotCounts.size()) && slotCounts[range] >= 0;
+}
+
+void GrassRenderer::updateRange(int range, const std::vector<glm::vec3>& positions) {
+    if (!isLiveRange(range)) return;
+
+    size_t count = std::min(positions.size(), static_cast<size_t>(SLOT_INSTANCES));
+    writeSlot(range, positions.data(), count);
+    setSlotCount(range, count);
+}
+
+void GrassRenderer::removeRange(int range) {
+    if (!isLiveRange(range)) return;
+
+    writeSlot(range, nullptr, 0);
+    setSlotCount(range, 0);
+    slotCounts[range] = -1;
+    freeSlots.push_back(range);
+    --slotsInUse;
+}
+
+void GrassRenderer::addChunk(Chunk& chunk) {
+    const std::vector<glm::vec3>& instances = chunk.getGrassInstances();
+    if (chunk.getGrassSlot() >= 0 || instances.empty()) return;
+
+    // The chunk keeps its vector: ChunkPool reuses the capacity for the next placement
+    chunk.setGrassSlot(addRange(instances));
+}
+
+void GrassRenderer::removeChunk(Chunk& chunk) {
+    int slot = chunk.getGrassSlot();
+    if (slot < 0) return;
+
+    removeRange(slot);
+    chunk.setGrassSlot(-1);
+}
+
+void GrassRenderer::updateChunk(Chunk& chunk) {
+    int slot = chunk.getGrassSlot();
+    if (slot < 0 || !chunk.takeGrassEdits(editedBlades)) return;
+
+    updateRange(slot, editedBlades);
 }
 
 void GrassRenderer::render(const glm::mat4& view, const glm::mat4& projection, float time) {
-    if (grassPositions.empty()) return;
+    if (instanceCount == 0) return;
 
-    shader->use();
-    shader->setMat4("view", view);
-    shader->setMat4("projection", projection);
-    shader->setFloat("time", time);
-    glBindVertexArray(VAO);
-    glDrawArraysInstanced(GL_TRIANGLES, 0, 3, static_cast<GLsizei>(grassPositions.size()));
+    if (cullProgram == 0) {
+        shader->use();
+        shader->setMat4("view", view);
+        shader->setMat4("projection", projection);
+        shader->setFloat("time", time);
+        glBindVertexArray(VAO);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 3, slotHighWater * SLOT_INSTANCES);
+        glBindVertexArray(0);
+        return;
+    }
+
+    cull(view, projection);
+
+    culledShader->use();
+    culledShader->setMat4("view", view);
+    culledShader->setMat4("projection", projection);
+    culledShader->setFloat("time", time);
+    if (transformFeedback != 0) {
+        glBindVertexArray(culledVAO[0]);
+        glDrawTransformFeedback(GL_TRIANGLES, transformFeedback);
+    } else {
+        // GL 3.3: last frame's buffer with the count its own query took; waits only if the GPU is a frame behind
+        int previous = captureBuffer ^ 1;
+        if (captured[previous]) {
+            GLuint vertices = 0;
+            glGetQueryObjectuiv(primitiveQueries[previous], GL_QUERY_RESULT, &vertices);
+            glBindVertexArray(culledVAO[previous]);
+            glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices));
+        }
+        captured[captureBuffer] = true;
+        captureBuffer = previous;
+    }
+    glBindVertexArray(0);
+}
+
+void GrassRenderer::cull(const glm::mat4& view, const glm::mat4& projection) {
+    glm::vec3 cameraPos = glm::vec3(glm::inverse(view)[3]);
+
+    glUseProgram(cullProgram);
+    glUniformMatrix4fv(cullUniforms[0], 1, GL_FALSE, &(projection * view)[0][0]);
+    glUniform3fv(cullUniforms[1], 1, &cameraPos[0]);
+    glUniform1f(cullUniforms[2], lod.fullDensityDistance);
+    glUniform1f(cullUniforms[3], lod.maxDistance);
+    glUniform1f(cullUniforms[4], lod.minDensity);
+    glUniform1f(cullUniforms[5], 0.35f);  // Blade height plus sway
+
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(cullVAO);
+    if (transformFeedback != 0) {
+        glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, transformFeedback);
+    } else {
+        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, culledVBO[captureBuffer]);
+        glBeginQuery(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN, primitiveQueries[captureBuffer]);
+    }
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, slotHighWater * SLOT_INSTANCES);
+    glEndTransformFeedback();
+    if (transformFeedback != 0) {
+        glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, 0);
+    } else {
+        glEndQuery(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN);
+    }
     glBindVertexArray(0);
-}
\ No newline at end of file
+    glDisable(GL_RASTERIZER_DISCARD);
+}
+
+void GrassRenderer::setupCulling() {
+    // GL 4.0 / ARB_transform_feedback2 draws the captured count directly; 3.3 alternates two buffers, each with its own count query
+    bool feedbackObjects = GLVersion.major >= 4 || GLAD_GL_ARB_transform_feedback2;
+
+    GLuint program = glCreateProgram();
+    GLuint stages[2] = {
+        compileStage(GL_VERTEX_SHADER, "shaders/grass_cull.vert"),
+        compileStage(GL_GEOMETRY_SHADER, "shaders/grass_cull.geom"),
+    };
+    for (GLuint stage : stages) {
+        if (stage != 0) glAttachShader(program, stage);
+    }
+    const char* varyings[] = {"bladeBase", "bladeCorner"};
+    glTransformFeedbackVaryings(program, 2, varyings, GL_INTERLEAVED_ATTRIBS);
+    glLinkProgram(program);
+    for (GLuint stage : stages) {
+        if (stage != 0) glDeleteShader(stage);
+    }
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked || stages[0] == 0 || stages[1] == 0) {
+        char log[1024] = {};
+        glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        Debug::logError(std::string("[GrassRenderer] Cull program failed; drawing without GPU culling: ") + log);
+        glDeleteProgram(program);
+        return;
+    }
+
+    cullProgram = program;
+    const char* uniformNames[] = {"viewProjection", "cameraPos", "fullDensityDistance", "maxDistance",
+                                  "minDensity", "cullRadius"};
+    for (int i = 0; i < 6; ++i) {
+        cullUniforms[i] = glGetUniformLocation(cullProgram, uniformNames[i]);
+    }
+    culledShader = std::make_unique<Shader>("shaders/grass_culled.vert", "shaders/grass.frag");
+
+    // Cull input: one point per instance slot entry
+    glGenVertexArrays(1, &cullVAO);
+    glBindVertexArray(cullVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+
+    // Cull output, drawn as plain triangles
+    const int outputBuffers = feedbackObjects ? 1 : 2;
+    glGenBuffers(outputBuffers, culledVBO);
+    glGenVertexArrays(outputBuffers, culledVAO);
+    for (int i = 0; i < outputBuffers; ++i) {
+        glBindVertexArray(culledVAO[i]);
+        glBindBuffer(GL_ARRAY_BUFFER, culledVBO[i]);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, CULLED_VERTEX_BYTES, (void*)0);
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, CULLED_VERTEX_BYTES, (void*)(4 * sizeof(float)));
+    }
+
+    if (feedbackObjects) {
+        glGenTransformFeedbacks(1, &transformFeedback);
+        glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, transformFeedback);
+        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, culledVBO[0]);
+        glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, 0);
+    } else {
+        glGenQueries(2, primitiveQueries);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    Debug::log(feedbackObjects ? "[GrassRenderer] GPU culling and distance LOD enabled"
+                               : "[GrassRenderer] GPU culling and distance LOD enabled (GL 3.3, double-buffered output)");
+}
@@ -3,23 +3,92 @@
 #include <vector>
 #include <glm/glm.hpp>
 #include <memory>
+#include "GrassSpawner.h"
+#include "MemoryTracker.h"
 
+class Chunk;
 class Shader;
 
+// Draws every resident chunk's grass from one instance buffer.
+//
+// The buffer is a pool of fixed-size ranges, one per chunk with grass. Adding,
+// updating or removing a range maps and rewrites only that range; unused tail
+// entries hold an off-screen sentinel the shaders drop. Freed ranges are
+// reused before the pool grows, and growth copies resident ranges on the GPU.
+//
+// Each frame a transform feedback pass (grass_cull.geom, rasterizer off)
+// drops blades outside the frustum or past maxDistance and thins the rest with
+// distance, writing the survivors' vertices to a compact buffer. With GL 4.0 /
+// ARB_transform_feedback2 the draw reads its vertex count straight from the
+// transform feedback object. GL 3.3 contexts alternate two output buffers, each
+// counted by its own query, and draw last frame's buffer with its count, which
+// the GPU has almost always finished by then.
 class GrassRenderer {
 public:
+    static constexpr int SLOT_INSTANCES = GrassSpawner::MAX_INSTANCES_PER_CHUNK;
+    static constexpr float SENTINEL_Y = -1.0e9f;  // Must match grass.vert and grass_cull.geom
+
+    struct LodSettings {
+        float fullDensityDistance = 48.0f;
+        float maxDistance = 320.0f;  // TerrainConstants::VIEW_DISTANCE chunks
+        float minDensity = 0.08f;    // Fraction of blades left at maxDistance
+    };
+
     GrassRenderer();
     ~GrassRenderer();
 
     void initialize();
-    void update(const std::vector<glm::vec3>& newPositions);
+
+    // Ranges hold up to SLOT_INSTANCES blades; extra positions are dropped. Main thread only.
+    int addRange(const std::vector<glm::vec3>& positions);
+    // Uploads straight from the caller's vector, which is consumed instead of copied
+    int addRange(std::vector<glm::vec3>&& positions);
+    void updateRange(int range, const std::vector<glm::vec3>& positions);
+    void removeRange(int range);
+
+    // Chunk wrappers: the range index is kept in the chunk's grass slot
+    void addChunk(Chunk& chunk);
+    void removeChunk(Chunk& chunk);
+    // Rewrites the chunk's range after terrain edits moved its blades
+    void updateChunk(Chunk& chunk);
     void render(const glm::mat4& view, const glm::mat4& projection, float time);
 
+    size_t getInstanceCount() const { return instanceCount; }
+    int getSlotsInUse() const { return slotsInUse; }
+    bool isCullingEnabled() const { return cullProgram != 0; }
+    void setLodSettings(const LodSettings& settings) { lod = settings; }
+
 private:
     unsigned int VAO, VBO, instanceVBO;
     std::unique_ptr<Shader> shader;
-    std::vector<glm::vec3> grassPositions;
+
+    int slotCapacity = 0;   // Slots the instance buffer can hold
+    int slotHighWater = 0;  // Draws cover slots [0, slotHighWater)
+    int slotsInUse = 0;
+    std::vector<int> freeSlots;
+    std::vector<int> slotCounts;  // Blades written to each slot; -1 once freed
+    size_t instanceCount = 0;
+    std::vector<glm::vec3> editedBlades;  // Reused by updateChunk
+    TrackedBytes gpuBytes{MemoryCategory::GrassGpu};
+
+    // GPU culling pass; left at 0 when unsupported or the program fails to build
+    unsigned int cullProgram = 0;
+    unsigned int cullVAO = 0, transformFeedback = 0;  // No feedback object on GL 3.3
+    // Cull output; GL 3.3 alternates both, each counted by a GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN
+    // query (which counts captured vertices: the pass emits points). Otherwise only [0] exists.
+    unsigned int culledVAO[2] = {}, culledVBO[2] = {}, primitiveQueries[2] = {};
+    bool captured[2] = {};  // GL 3.3: the buffer holds a capture its query describes
+    int captureBuffer = 0;  // GL 3.3: written by this frame's cull
+    std::unique_ptr<Shader> culledShader;
+    int cullUniforms[6] = {};
+    LodSettings lod;
 
     void setupBlade();
-    void updateInstanceBuffer();
+    void setupCulling();
+    void cull(const glm::mat4& view, const glm::mat4& projection);
+    int allocateSlot();
+    void setSlotCount(int slot, size_t count);
+    bool isLiveRange(int range) const;
+    void writeSlot(int slot, const glm::vec3* positions, size_t count);
+    void growInstanceBuffer(int minSlots);
 };
@@ -1,29 +1,33 @@
 #include "GrassSpawner.h"
-#include "Terrain.h"
-#include "FastNoiseLiteWrapper.h"
+#include <FastNoiseLite.h>
 
-GrassSpawner::GrassSpawner(std::shared_ptr<Terrain> terrain, int density)
-    : terrain(std::move(terrain)), density(density) {}
-
-void GrassSpawner::generate() {
-    grassPositions.clear();
+namespace {
+    const FastNoiseLite& placementNoise() {
+        static const FastNoiseLite noise = [] {
+            FastNoiseLite n;
+            n.SetSeed(1337);
+            n.SetFrequency(0.1f);
+            return n;
+        }();
+        return noise;
+    }
+}
 
-    int worldSize = 512; // or get this from terrain if dynamic
-    FastNoiseLite noise;
-    noise.SetSeed(1337);
-    noise.SetFrequency(0.1f);
+void GrassSpawner::placeInChunk(int chunkX, int chunkZ, const float* heights, std::vector<glm::vec3>& out) {
+    constexpr int SIZE = ChunkConstants::SIZE;
+    static_assert(SIZE % DENSITY == 0, "Chunk size must be a multiple of the grass density");
 
-    for (int x = 0; x < worldSize; x += density) {
-        for (int z = 0; z < worldSize; z += density) {
-            float chance = noise.GetNoise((float)x, (float)z);
-            if (chance > 0.2f) {
-                float y = terrain->getHeightAt((float)x, (float)z);
-                grassPositions.emplace_back(x, y, z);
+    const FastNoiseLite& noise = placementNoise();
+    const int originX = chunkX * SIZE;
+    const int originZ = chunkZ * SIZE;
+    // Chunk origins are multiples of DENSITY, so every chunk samples the same world lattice
+    for (int localX = 0; localX < SIZE; localX += DENSITY) {
+        for (int localZ = 0; localZ < SIZE; localZ += DENSITY) {
+            float x = static_cast<float>(originX + localX);
+            float z = static_cast<float>(originZ + localZ);
+            if (noise.GetNoise(x, z) > 0.2f) {
+                out.emplace_back(x, heights[localZ * (SIZE + 1) + localX], z);
             }
         }
     }
 }
-
-const std::vector<glm::vec3>& GrassSpawner::getGrassPositions() const {
-    return grassPositions;
-}
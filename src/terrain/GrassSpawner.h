@@ -2,20 +2,18 @@
 
 #include <vector>
 #include <glm/glm.hpp>
-#include <memory>
-
-class Terrain;
-class FastNoiseLite;
+#include "ChunkConstants.h"
 
+// Grass placement for one chunk, run by Chunk::generate on the worker that
+// built the heights, so blades follow streaming instead of covering a fixed
+// area around the origin.
 class GrassSpawner {
 public:
-    GrassSpawner(std::shared_ptr<Terrain> terrain, int density = 2);
-
-    void generate();
-    const std::vector<glm::vec3>& getGrassPositions() const;
+    static constexpr int DENSITY = 2;  // One candidate blade every N world units
+    static constexpr int MAX_INSTANCES_PER_CHUNK =
+        (ChunkConstants::SIZE / DENSITY) * (ChunkConstants::SIZE / DENSITY);
 
-private:
-    std::shared_ptr<Terrain> terrain;
-    std::vector<glm::vec3> grassPositions;
-    int density; // e.g., one blade every N tiles
+    // Appends world-space blade positions; heights is the chunk's (SIZE + 1)^2 vertex grid.
+    // Only the chunk's own [0, SIZE) columns and rows are used so shared borders are not doubled.
+    static void placeInChunk(int chunkX, int chunkZ, const float* heights, std::vector<glm::vec3>& out);
 };
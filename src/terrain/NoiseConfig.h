@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
 #include <vector>
 
 struct NoiseLayer {
@@ -14,6 +16,28 @@ struct NoiseConfig {
     float baseFrequency = 0.01f;
     float baseAmplitude = 1.0f;
     std::vector<NoiseLayer> layers;
+
+    // FNV-1a over every parameter; used to key cached terrain to the config that produced it
+    uint64_t hash() const {
+        uint64_t h = 1469598103934665603ULL;
+        auto mix = [&h](const void* data, size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                h ^= bytes[i];
+                h *= 1099511628211ULL;
+            }
+        };
+        mix(&baseFrequency, sizeof(baseFrequency));
+        mix(&baseAmplitude, sizeof(baseAmplitude));
+        for (const auto& layer : layers) {
+            mix(&layer.frequency, sizeof(layer.frequency));
+            mix(&layer.amplitude, sizeof(layer.amplitude));
+            mix(&layer.persistence, sizeof(layer.persistence));
+            mix(&layer.lacunarity, sizeof(layer.lacunarity));
+            mix(&layer.octaves, sizeof(layer.octaves));
+        }
+        return h;
+    }
     
     // Static factory methods for different terrain types
     static NoiseConfig Plains() {
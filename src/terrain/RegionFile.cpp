@@ -0,0 +1,271 @@
+#include "RegionFile.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <vector>
+#include "Debug.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr char MAGIC[4] = {'T', 'R', 'G', 'N'};
+
+    void writeHeaderPrefix(std::vector<uint8_t>& out, uint64_t worldKey) {
+        uint32_t version = RegionFile::VERSION;
+        std::memcpy(out.data(), MAGIC, 4);
+        std::memcpy(out.data() + 4, &version, 4);
+        std::memcpy(out.data() + 8, &worldKey, 8);
+    }
+}
+
+RegionFile::RegionFile(std::string path, uint64_t worldKey)
+    : path(std::move(path))
+    , worldKey(worldKey)
+{
+}
+
+RegionFile::~RegionFile() {
+    unmapFile();
+}
+
+bool RegionFile::headerValid() const {
+    if (!mapped || mappedSize < HEADER_SIZE) return false;
+
+    uint32_t version = 0;
+    uint64_t key = 0;
+    std::memcpy(&version, mapped + 4, 4);
+    std::memcpy(&key, mapped + 8, 8);
+    return std::memcmp(mapped, MAGIC, 4) == 0 && version == VERSION && key == worldKey;
+}
+
+bool RegionFile::readMapped(size_t index, const PayloadReader& reader) const {
+    if (!headerValid()) return false;
+
+    Entry entry{};
+    std::memcpy(&entry, mapped + 16 + index * sizeof(Entry), sizeof(Entry));
+    if (entry.size == 0 || static_cast<size_t>(entry.offset) + entry.size > mappedSize) {
+        return false;
+    }
+    return reader(mapped + entry.offset, entry.size);
+}
+
+bool RegionFile::read(int localX, int localZ, const PayloadReader& reader) {
+    size_t index = entryIndex(localX, localZ);
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        if (!stale) {
+            return readMapped(index, reader);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (stale) {
+        mapFile();
+    }
+    return readMapped(index, reader);
+}
+
+bool RegionFile::write(int localX, int localZ, const uint8_t* data, size_t size) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    unmapFile();
+    stale = true;
+
+    std::vector<uint8_t> header(HEADER_SIZE, 0);
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    bool fresh = !file.is_open();
+    if (!fresh) {
+        file.read(reinterpret_cast<char*>(header.data()), static_cast<std::streamsize>(header.size()));
+        uint32_t version = 0;
+        uint64_t key = 0;
+        std::memcpy(&version, header.data() + 4, 4);
+        std::memcpy(&key, header.data() + 8, 8);
+        fresh = !file || std::memcmp(header.data(), MAGIC, 4) != 0 || version != VERSION || key != worldKey;
+        file.clear();
+    }
+    if (fresh) {
+        // Missing, foreign or outdated file: start a new region
+        std::fill(header.begin(), header.end(), 0);
+    }
+
+    std::vector<Entry> table(ENTRY_COUNT);
+    std::memcpy(table.data(), header.data() + 16, ENTRY_COUNT * sizeof(Entry));
+    const size_t index = entryIndex(localX, localZ);
+    uint64_t liveBytes = size;
+    for (size_t i = 0; i < ENTRY_COUNT; ++i) {
+        if (i != index) liveBytes += table[i].size;
+    }
+    if (HEADER_SIZE + liveBytes > UINT32_MAX) {
+        Debug::logError("[RegionFile] " + path + " would exceed 4 GB of live payloads");
+        return false;
+    }
+
+    uint64_t fileSize = HEADER_SIZE;
+    if (!fresh) {
+        file.seekp(0, std::ios::end);
+        std::streamoff end = file.tellp();
+        fileSize = end > 0 ? static_cast<uint64_t>(end) : HEADER_SIZE;
+    }
+    // Everything the table will no longer reference, including this chunk's old payload
+    uint64_t deadBytes = fileSize - std::min<uint64_t>(fileSize, HEADER_SIZE + liveBytes - size);
+    if (fresh || fileSize + size > UINT32_MAX || deadBytes > std::max(liveBytes, REWRITE_MIN_DEAD_BYTES)) {
+        file.close();
+        return rewrite(table.data(), fresh ? 0 : fileSize, index, data, size);
+    }
+    std::streamoff offset = static_cast<std::streamoff>(fileSize);
+
+    // Payload first, then the table entry, so a torn write leaves the old entry intact
+    file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    Entry entry{static_cast<uint32_t>(offset), static_cast<uint32_t>(size)};
+    file.seekp(static_cast<std::streamoff>(16 + entryIndex(localX, localZ) * sizeof(Entry)));
+    file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    return static_cast<bool>(file);
+}
+
+bool RegionFile::rewrite(const Entry* table, uint64_t fileSize, size_t index, const uint8_t* data, size_t size) {
+    const std::string tempPath = path + ".tmp";
+    std::ifstream old;
+    if (fileSize > 0) {
+        old.open(path, std::ios::binary);
+    }
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        Debug::logError("[RegionFile] Unable to create " + tempPath);
+        return false;
+    }
+
+    // Header last: payload offsets are only known once they are written
+    std::vector<uint8_t> header(HEADER_SIZE, 0);
+    writeHeaderPrefix(header, worldKey);
+    out.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+
+    std::vector<Entry> newTable(ENTRY_COUNT, Entry{0, 0});
+    uint32_t offset = static_cast<uint32_t>(HEADER_SIZE);
+    std::vector<char> payload;
+    for (size_t i = 0; i < ENTRY_COUNT && old.is_open(); ++i) {
+        const Entry& entry = table[i];
+        // Entries pointing past the end were torn writes; drop them like readMapped would
+        if (i == index || entry.size == 0 || static_cast<uint64_t>(entry.offset) + entry.size > fileSize) continue;
+
+        payload.resize(entry.size);
+        old.seekg(entry.offset);
+        if (!old.read(payload.data(), entry.size)) continue;
+        out.write(payload.data(), entry.size);
+        newTable[i] = {offset, entry.size};
+        offset += entry.size;
+    }
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    newTable[index] = {offset, static_cast<uint32_t>(size)};
+
+    std::memcpy(header.data() + 16, newTable.data(), ENTRY_COUNT * sizeof(Entry));
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    out.close();
+    old.close();
+    if (!out) {
+        Debug::logError("[RegionFile] Failed writing " + tempPath);
+        return false;
+    }
+
+    // The old file stays valid until the rename replaces it
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        Debug::logError("[RegionFile] Unable to replace " + path + ": " + ec.message());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+#ifdef _WIN32
+
+void RegionFile::mapFile() {
+    unmapFile();
+    stale = false;
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || static_cast<size_t>(size.QuadPart) < HEADER_SIZE) {
+        CloseHandle(file);
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    mapped = static_cast<const uint8_t*>(view);
+    mappedSize = static_cast<size_t>(size.QuadPart);
+}
+
+void RegionFile::unmapFile() {
+    if (mapped) UnmapViewOfFile(mapped);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    mapped = nullptr;
+    mappedSize = 0;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+}
+
+#else
+
+void RegionFile::mapFile() {
+    unmapFile();
+    stale = false;
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < HEADER_SIZE) {
+        close(fd);
+        return;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the file referenced
+    if (view == MAP_FAILED) return;
+
+    mapped = static_cast<const uint8_t*>(view);
+    mappedSize = static_cast<size_t>(st.st_size);
+}
+
+void RegionFile::unmapFile() {
+    if (mapped) {
+        munmap(const_cast<uint8_t*>(mapped), mappedSize);
+    }
+    mapped = nullptr;
+    mappedSize = 0;
+}
+
+#endif
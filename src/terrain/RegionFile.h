@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+
+// One region file holds up to REGION_SIZE x REGION_SIZE chunk payloads.
+//
+// Layout: header { magic "TRGN", version, worldKey, offset table } followed by
+// payloads appended in write order. Each table entry is { offset, size } in bytes,
+// zero when the chunk is absent. Reads go through a read-only memory mapping so
+// payloads are decoded straight from the page cache; writes append and invalidate
+// the mapping. Replaced payloads stay behind as dead bytes until they outweigh the
+// live ones, then the next write copies the live payloads into a temporary file
+// that replaces the region, so a file stays within about twice its live size.
+class RegionFile {
+public:
+    static constexpr int REGION_SIZE = 32;
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint64_t REWRITE_MIN_DEAD_BYTES = 64 * 1024;  // Below this, appending is always cheaper
+
+    using PayloadReader = std::function<bool(const uint8_t* data, size_t size)>;
+
+    RegionFile(std::string path, uint64_t worldKey);
+    ~RegionFile();
+
+    RegionFile(const RegionFile&) = delete;
+    RegionFile& operator=(const RegionFile&) = delete;
+
+    // Calls reader with the mapped payload bytes; the view is only valid during the call
+    bool read(int localX, int localZ, const PayloadReader& reader);
+    // False (and the region unchanged) if the live payloads would pass the 4 GB offset limit
+    bool write(int localX, int localZ, const uint8_t* data, size_t size);
+
+    const std::string& getPath() const { return path; }
+
+private:
+    struct Entry {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    static constexpr size_t ENTRY_COUNT = REGION_SIZE * REGION_SIZE;
+    static constexpr size_t HEADER_SIZE = 16 + ENTRY_COUNT * sizeof(Entry);
+
+    static size_t entryIndex(int localX, int localZ) { return static_cast<size_t>(localZ) * REGION_SIZE + localX; }
+
+    bool readMapped(size_t index, const PayloadReader& reader) const;
+    // Writes the live payloads of table plus the new one at index into a fresh file, then swaps it in
+    bool rewrite(const Entry* table, uint64_t fileSize, size_t index, const uint8_t* data, size_t size);
+    bool headerValid() const;
+    void mapFile();
+    void unmapFile();
+
+    std::string path;
+    uint64_t worldKey;
+    std::shared_mutex mutex;
+
+    const uint8_t* mapped = nullptr;
+    size_t mappedSize = 0;
+    bool stale = true;  // Mapping must be (re)created before the next read
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
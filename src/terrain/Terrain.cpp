@@ -1,20 +1,63 @@
 #include "Terrain.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
 #include "BiomeManager.h"
+#include "ChunkCache.h"
 #include "ChunkConstants.h"
+#include "ChunkHash.h"
 #include "DefaultChunkFactory.h"
+#include "GridWalk.h"
+#include "ScratchArena.h"
+#include "TerrainBrush.h"
 #include "TerrainConstants.h"
+#include "TerrainEditLog.h"
 #include "TerrainNoiseFactory.h"
 #include "ChunkManager.h"
+#include "Debug.h"
+#include "Profiler.h"
 #include "TerrainThreadPool.h"
+#include "WorldConstants.h"
 
 static inline BiomeManager biomeManager;
 
+namespace {
+    int floorDiv(int value, int divisor) {
+        int quotient = value / divisor;
+        return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+    }
+}
+
 struct TerrainImpl {
     std::unique_ptr<ChunkManager> chunkManager;
+    std::unique_ptr<ChunkCache> chunkCache;
+    std::string chunkCacheDirectory;
+    bool chunkCacheWriteBack = true;
+    std::unique_ptr<TerrainEditLog> editLog;
+    // Stand-in for the log when edits are not persisted; workers read it while generating
+    std::mutex unloggedMutex;
+    uint64_t editSequence = 0;
+    std::unordered_map<std::pair<int, int>, float, ChunkPairHash> unloggedOffsets;  // Vertex -> offset
+
+    // SIZE x SIZE vertices of edited heights, so the simulation samples noise once per vertex
+    struct EditedHeightTile {
+        std::vector<float> noise;   // getHeightAt, fixed
+        std::vector<float> edited;  // noise + edit offset as of `sequence`
+        uint64_t sequence = 0;      // Edit sequence `edited` reflects
+        uint64_t lastEdit = 0;      // Latest edit touching the tile; refresh when ahead of `sequence`
+    };
+    static constexpr size_t MAX_HEIGHT_TILES = 256;  // ~2 MB; cleared when full, refilled on demand
+    std::unordered_map<std::pair<int, int>, EditedHeightTile, ChunkPairHash> heightTiles;  // Main thread
+    TerrainThreadPool& threadPool;
     TerrainImpl(TerrainThreadPool& threadPool) 
-        : chunkManager(std::make_unique<ChunkManager>(threadPool, 512)) {} // Limit to 512 chunks max
+        : chunkManager(std::make_unique<ChunkManager>(threadPool))
+        , threadPool(threadPool) {}
 };
 
 Terrain::Terrain(TerrainThreadPool& threadPool) 
@@ -33,8 +76,7 @@ Terrain::~Terrain() = default;
 
 TerrainType Terrain::getTerrainTypeAt(float worldX, float worldZ)
 {
-    Biome biome = biomeManager.getBiomeForPosition(worldX, worldZ);
-    return biome.getDominantTerrain();
+    return biomeManager.getBiomeForPosition(worldX, worldZ).getDominantTerrain();  // No Biome copy per sample
 }
 
 float Terrain::getHeightAt(float worldX, float worldZ)
@@ -45,8 +87,10 @@ float Terrain::getHeightAt(float worldX, float worldZ)
     // Get the noise function for the actual terrain type
     auto noiseFn = noiseFactory->getNoise(terrainType);
     
-    // Get biome weights for potential blending
-    auto biomeWeights = biomeManager.getBiomeWeightsAt(worldX, worldZ);
+    // Get biome weights for potential blending; the map lives in this thread's scratch arena
+    ScratchArena& arena = ScratchArena::forThread();
+    ScratchArena::Scope scratch(arena);
+    auto biomeWeights = biomeManager.getBiomeWeightsAt(worldX, worldZ, &arena);
     
     // If we have multiple biomes influencing this point, blend their heights
     if (biomeWeights.size() > 1) {
@@ -87,129 +131,515 @@ void Terrain::initialize(std::shared_ptr<TerrainNoiseFactory> sharedNoiseFactory
     // Initialize the ChunkManager with our shared_ptr
     initializeChunkManager();
 
-    // Load immediate chunks around spawn first
-    const int initialRadius = 2;
-    const int totalSteps = (2 * initialRadius + 1) * (2 * initialRadius + 1);
-    int currentStep = 0;
-
-    // First pass: Load the immediate chunks (3x3 grid)
-    for (int z = -1; z <= 1; ++z) {
-        for (int x = -1; x <= 1; ++x) {
-            auto chunk = chunkFactory->createChunk(x, z, shared_from_this());
-            chunks[{x, z}] = chunk;
-            // Generate and upload immediately for spawn chunks
-            chunk->generate();
-            chunk->uploadToGPU();
-            if (progressCallback) {
-                float progress = static_cast<float>(++currentStep) / totalSteps * 0.5f;
-                progressCallback(progress);
+    // Cache key depends on the noise factory and biome layout set up above
+    openChunkCache();
+
+    // Chunks around spawn are generated and uploaded before the first frame
+    const int spawnRadius = 2;
+    generateSpawnArea(spawnRadius, progressCallback);
+}
+
+namespace {
+    // Shared between generateSpawnArea() and the pool tasks, which may outlive it if they never claim a chunk
+    struct SpawnBatch {
+        std::vector<std::shared_ptr<Chunk>> chunks;  // Nearest to spawn first
+        std::atomic<size_t> nextChunk{0};
+        std::mutex doneMutex;
+        std::condition_variable doneSignal;
+        std::vector<Chunk*> done;  // Generated, waiting for the GL thread
+
+        // Claims and generates one chunk; false once none are left
+        bool generateNext() {
+            size_t i = nextChunk.fetch_add(1);
+            if (i >= chunks.size()) return false;
+
+            Chunk* chunk = chunks[i].get();
+            try {
+                chunk->generate();
             }
+            catch (const std::exception& e) {
+                Debug::logError(std::string("[Terrain] Spawn chunk generation failed: ") + e.what());
+            }
+            {
+                std::lock_guard<std::mutex> lock(doneMutex);
+                done.push_back(chunk);
+            }
+            doneSignal.notify_one();
+            return true;
+        }
+    };
+}
+
+void Terrain::generateSpawnArea(int radius, const std::function<void(float)>& progressCallback)
+{
+    PROFILE_SCOPE("Terrain::generateSpawnArea");
+
+    // Square rings outward so the area under the player is ready first
+    std::vector<std::pair<int, int>> coords;
+    for (int z = -radius; z <= radius; ++z) {
+        for (int x = -radius; x <= radius; ++x) {
+            coords.emplace_back(x, z);
         }
     }
+    std::stable_sort(coords.begin(), coords.end(), [](const auto& a, const auto& b) {
+        return std::max(std::abs(a.first), std::abs(a.second)) < std::max(std::abs(b.first), std::abs(b.second));
+    });
 
-    // Second pass: Load the remaining chunks in the view distance
-    for (int z = -initialRadius; z <= initialRadius; ++z) {
-        for (int x = -initialRadius; x <= initialRadius; ++x) {
-            if (std::abs(x) <= 1 && std::abs(z) <= 1) continue; // Skip already loaded chunks
-            chunks[{x, z}] = chunkFactory->createChunk(x, z, shared_from_this());
+    auto batch = std::make_shared<SpawnBatch>();
+    for (const auto& [x, z] : coords) {
+        auto chunk = chunkFactory->createChunk(x, z, shared_from_this());
+        if (!chunk || !chunk->requestGeneration()) continue;
+        impl->chunkManager->adoptChunk(x, z, chunk);
+        batch->chunks.push_back(std::move(chunk));
+    }
+
+    // Workers pull from the shared list (cached heights come back fast, misses are generated);
+    // the main thread uploads finished chunks as they arrive and generates when it has nothing to upload
+    const size_t total = batch->chunks.size();
+    const size_t helpers = std::min(impl->threadPool.getWorkerCount(), total);
+    for (size_t i = 0; i < helpers; ++i) {
+        impl->threadPool.queueTask([batch] { while (batch->generateNext()) {} });
+    }
+
+    std::vector<Chunk*> ready;
+    size_t completed = 0;
+    while (completed < total) {
+        {
+            std::unique_lock<std::mutex> lock(batch->doneMutex);
+            if (batch->done.empty() && batch->nextChunk.load() >= total) {
+                // Everything is claimed: wait for the workers
+                batch->doneSignal.wait(lock, [&batch] { return !batch->done.empty(); });
+            }
+            ready.swap(batch->done);
+        }
+        if (ready.empty()) {
+            batch->generateNext();
+            continue;
+        }
+
+        for (Chunk* chunk : ready) {
+            if (chunk->getState() == Chunk::State::Generated) {
+                chunk->uploadToGPU();
+            }
+            ++completed;
             if (progressCallback) {
-                float progress = 0.5f + static_cast<float>(++currentStep) / totalSteps * 0.5f;
-                progressCallback(progress);
+                progressCallback(static_cast<float>(completed) / total);
             }
         }
+        ready.clear();
     }
 }
 
-const std::map<std::pair<int, int>, std::shared_ptr<Chunk>>& Terrain::getChunks() const {
-    return chunks;
+void Terrain::enableChunkCache(const std::string& directory)
+{
+    impl->chunkCacheDirectory = directory;
+    if (noiseFactory) {
+        openChunkCache();
+    }
 }
 
-std::vector<std::shared_ptr<Chunk>> Terrain::getVisibleChunks(float playerX, float playerZ) const {
-    std::vector<std::shared_ptr<Chunk>> visible;
-    for (const auto& [coord, chunk] : chunks) {
-        float dist = glm::distance(glm::vec2(coord.first * 16, coord.second * 16), glm::vec2(playerX, playerZ));
-        if (dist <= TerrainConstants::TERRAIN_RENDER_DISTANCE) {
-            visible.push_back(chunk);
+void Terrain::openChunkCache()
+{
+    if (impl->chunkCacheDirectory.empty() || !noiseFactory) return;
+
+    // Everything that changes generated heights goes into the key
+    uint64_t key = 1469598103934665603ULL;
+    auto mix = [&key](uint64_t value) {
+        key ^= value + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+    };
+    mix(static_cast<uint64_t>(WorldConstants::SEED));
+    mix(static_cast<uint64_t>(ChunkConstants::SIZE));
+    mix(noiseFactory->getConfigHash());
+    for (const auto& [center, biome] : biomeManager.getBiomeCenters()) {
+        uint32_t x = 0, z = 0;
+        std::memcpy(&x, &center.x, sizeof(x));
+        std::memcpy(&z, &center.y, sizeof(z));
+        mix((static_cast<uint64_t>(x) << 32) | z);
+        mix(static_cast<uint64_t>(biome.getDominantTerrain()));
+    }
+
+    if (impl->chunkCache && impl->chunkCache->getWorldKey() == key) return;
+    impl->chunkCache = std::make_unique<ChunkCache>(impl->chunkCacheDirectory, key);
+}
+
+bool Terrain::loadCachedHeights(int chunkX, int chunkZ, std::pmr::vector<float>& heights)
+{
+    return impl->chunkCache && impl->chunkCache->load(chunkX, chunkZ, heights);
+}
+
+void Terrain::storeCachedHeights(int chunkX, int chunkZ, const std::pmr::vector<float>& heights)
+{
+    // The write-back queue outlives the caller's scratch memory, so it gets its own copy
+    if (impl->chunkCache && impl->chunkCacheWriteBack) {
+        impl->chunkCache->store(chunkX, chunkZ, std::vector<float>(heights.begin(), heights.end()));
+    }
+}
+
+ChunkCache* Terrain::getChunkCache() const
+{
+    return impl->chunkCache.get();
+}
+
+void Terrain::setChunkCacheWriteBack(bool enabled)
+{
+    impl->chunkCacheWriteBack = enabled;
+}
+
+void Terrain::enableEditLog(const std::string& directory)
+{
+    // Edits are offsets from generated terrain, so they only carry over within the same seed
+    impl->editLog = std::make_unique<TerrainEditLog>(directory, static_cast<uint64_t>(WorldConstants::SEED));
+    impl->heightTiles.clear();  // Offsets now come from the log
+}
+
+void Terrain::setChunkUnloadCallback(std::function<void(Chunk&)> callback)
+{
+    impl->chunkManager->setUnloadCallback(std::move(callback));
+}
+
+void Terrain::setMemoryBudget(size_t bytes)
+{
+    impl->chunkManager->setMemoryBudget(bytes);
+}
+
+size_t Terrain::getResidentChunkBytes() const
+{
+    return impl->chunkManager->getResidentBytes();
+}
+
+bool Terrain::applyHeightEdits(int chunkX, int chunkZ, std::pmr::vector<float>& heights, uint64_t* appliedSequence)
+{
+    if (impl->editLog) {
+        return impl->editLog->applyOverlay(chunkX, chunkZ, heights, appliedSequence);
+    }
+
+    std::lock_guard<std::mutex> lock(impl->unloggedMutex);
+    if (appliedSequence) *appliedSequence = impl->editSequence;
+    if (impl->unloggedOffsets.empty()) return false;
+
+    constexpr int SIZE = ChunkConstants::SIZE;
+    bool edited = false;
+    for (int z = 0; z <= SIZE; ++z) {
+        for (int x = 0; x <= SIZE; ++x) {
+            auto it = impl->unloggedOffsets.find({chunkX * SIZE + x, chunkZ * SIZE + z});
+            if (it == impl->unloggedOffsets.end()) continue;
+            heights[z * (SIZE + 1) + x] += it->second;
+            edited = true;
         }
     }
-    return visible;
+    return edited;
 }
 
-void Terrain::updateChunks(float playerX, float playerZ)
+TerrainEditLog* Terrain::getEditLog() const
 {
-    int playerChunkX = static_cast<int>(floor(playerX / ChunkConstants::SIZE));
-    int playerChunkZ = static_cast<int>(floor(playerZ / ChunkConstants::SIZE));
+    return impl->editLog.get();
+}
 
-    const int viewDistance = TerrainConstants::VIEW_DISTANCE;
+float Terrain::getVertexHeight(int vertexX, int vertexZ)
+{
+    float height = 0.0f;
+    bool resident = false;
+    TerrainEditLog::forEachSharingChunk(vertexX, vertexZ, [&](int chunkX, int chunkZ, int localX, int localZ) {
+        if (resident) return;
+        if (auto chunk = impl->chunkManager->findChunk(chunkX, chunkZ)) {
+            height = chunk->getVertexHeight(localX, localZ);
+            resident = true;
+        }
+    });
+    if (resident) return height;
 
-    // Only use ChunkManager to handle loading/unloading
-    impl->chunkManager->updateLoadedChunks(
-        glm::vec3(playerX, 0, playerZ),
-        viewDistance * ChunkConstants::SIZE
-    );
+    return getEditedVertexHeight(vertexX, vertexZ);
+}
+
+float Terrain::getEditOffset(int vertexX, int vertexZ)
+{
+    if (impl->editLog) return impl->editLog->getOffset(vertexX, vertexZ);
+    std::lock_guard<std::mutex> lock(impl->unloggedMutex);
+    auto it = impl->unloggedOffsets.find({vertexX, vertexZ});
+    return it != impl->unloggedOffsets.end() ? it->second : 0.0f;
+}
+
+float Terrain::getEditedVertexHeight(int vertexX, int vertexZ)
+{
+    constexpr int SIZE = ChunkConstants::SIZE;
+    int tileX = floorDiv(vertexX, SIZE);
+    int tileZ = floorDiv(vertexZ, SIZE);
+    int originX = tileX * SIZE;
+    int originZ = tileZ * SIZE;
 
-    // Remove chunks that are no longer in the ChunkManager
-    for (auto it = chunks.begin(); it != chunks.end();) {
-        int chunkX = it->first.first;
-        int chunkZ = it->first.second;
+    auto it = impl->heightTiles.find({tileX, tileZ});
+    if (it == impl->heightTiles.end()) {
+        if (impl->heightTiles.size() >= TerrainImpl::MAX_HEIGHT_TILES) impl->heightTiles.clear();
+        TerrainImpl::EditedHeightTile tile;
+        tile.noise.resize(SIZE * SIZE);
+        for (int z = 0; z < SIZE; ++z) {
+            for (int x = 0; x < SIZE; ++x) {
+                tile.noise[z * SIZE + x] = getHeightAt(static_cast<float>(originX + x), static_cast<float>(originZ + z));
+            }
+        }
+        it = impl->heightTiles.emplace(std::make_pair(tileX, tileZ), std::move(tile)).first;
+    }
 
-        if (!impl->chunkManager->getChunk(chunkX, chunkZ)) {
-            it = chunks.erase(it);
-        } else {
-            ++it;
+    auto& tile = it->second;
+    if (tile.edited.empty() || tile.sequence != tile.lastEdit) {
+        // Same sum as the chunks' overlay, so cached and freshly generated heights agree exactly
+        tile.edited.resize(SIZE * SIZE);
+        for (int z = 0; z < SIZE; ++z) {
+            for (int x = 0; x < SIZE; ++x) {
+                tile.edited[z * SIZE + x] = tile.noise[z * SIZE + x] + getEditOffset(originX + x, originZ + z);
+            }
         }
+        tile.sequence = tile.lastEdit;
     }
+    return tile.edited[(vertexZ - originZ) * SIZE + (vertexX - originX)];
+}
+
+float Terrain::sampleEditedHeight(float worldX, float worldZ)
+{
+    int x = static_cast<int>(std::floor(worldX));
+    int z = static_cast<int>(std::floor(worldZ));
+    float fx = worldX - x;
+    float fz = worldZ - z;
+
+    // Same split as Chunk::sampleHeight (top-right to bottom-left); chunk origins are whole vertices
+    float topLeft = getEditedVertexHeight(x, z);
+    float topRight = getEditedVertexHeight(x + 1, z);
+    float bottomLeft = getEditedVertexHeight(x, z + 1);
+    if (fx + fz <= 1.0f)
+        return topLeft + fx * (topRight - topLeft) + fz * (bottomLeft - topLeft);
+    float bottomRight = getEditedVertexHeight(x + 1, z + 1);
+    return bottomRight + (1.0f - fx) * (bottomLeft - bottomRight) + (1.0f - fz) * (topRight - bottomRight);
+}
 
-    // Update our chunks map with any new chunks from the manager
-    for (int z = -viewDistance; z <= viewDistance; ++z) {
-        for (int x = -viewDistance; x <= viewDistance; ++x) {
-            int chunkX = playerChunkX + x;
-            int chunkZ = playerChunkZ + z;
+std::optional<glm::vec3> Terrain::raycastEdited(const glm::vec3& origin, const glm::vec3& dir, float maxDistance)
+{
+    PROFILE_SCOPE("Terrain::raycastEdited");
+    float length = glm::length(dir);
+    if (length <= 0.0f || maxDistance <= 0.0f) return std::nullopt;
+    const glm::vec3 unitDir = dir / length;
+
+    // Half-cell steps, then bisection between the last point above and the first below
+    constexpr float MARCH_STEP = 0.5f;
+    constexpr int REFINE_STEPS = 10;
+    auto below = [&](float t) {
+        glm::vec3 p = origin + unitDir * t;
+        return p.y <= sampleEditedHeight(p.x, p.z);
+    };
+    if (below(0.0f)) return origin;
 
-            auto chunk = impl->chunkManager->getChunk(chunkX, chunkZ);
-            if (chunk && chunks.find({chunkX, chunkZ}) == chunks.end()) {
-                chunks[{chunkX, chunkZ}] = chunk;
+    float above = 0.0f;
+    for (float t = MARCH_STEP; above < maxDistance; t += MARCH_STEP) {
+        t = std::min(t, maxDistance);
+        if (below(t)) {
+            float hit = t;
+            for (int i = 0; i < REFINE_STEPS; ++i) {
+                float mid = 0.5f * (above + hit);
+                if (below(mid))
+                    hit = mid;
+                else
+                    above = mid;
             }
+            return origin + unitDir * hit;
         }
+        above = t;
     }
+    return std::nullopt;
 }
 
-void Terrain::loadChunk(int chunkX, int chunkZ)
+float Terrain::queryHeight(float worldX, float worldZ)
 {
-    // First check if chunk exists in manager
-    auto chunk = impl->chunkManager->getChunk(chunkX, chunkZ);
-    if (!chunk) {
-        // Load through manager if not exists
-        impl->chunkManager->loadChunk(chunkX, chunkZ, shared_from_this());
-        chunk = impl->chunkManager->getChunk(chunkX, chunkZ);
-        if (chunk) {
-            chunks[{chunkX, chunkZ}] = chunk;
+    const float size = static_cast<float>(ChunkConstants::SIZE);
+    int chunkX = static_cast<int>(std::floor(worldX / size));
+    int chunkZ = static_cast<int>(std::floor(worldZ / size));
+    float height = 0.0f;
+    if (auto chunk = impl->chunkManager->findChunk(chunkX, chunkZ)) {
+        if (chunk->sampleHeight(worldX - chunkX * size, worldZ - chunkZ * size, height)) {
+            return height;
         }
     }
+    return getHeightAt(worldX, worldZ);
 }
 
-void Terrain::unloadFarChunks(int centerX, int centerZ, int radius)
+namespace {
+    // Shared between raycastBatch() and the pool tasks; tasks that start after every block
+    // is claimed leave without touching the caller's arrays
+    struct RayBatch {
+        static constexpr size_t BLOCK = 32;  // Rays per claim
+
+        const Terrain* terrain = nullptr;
+        const Terrain::Ray* rays = nullptr;
+        Terrain::RayHit* hits = nullptr;
+        std::vector<uint32_t> order;  // Ray indices grouped by starting chunk
+        size_t blockCount = 0;
+        std::atomic<size_t> nextBlock{0};
+        std::atomic<size_t> doneBlocks{0};
+        std::mutex doneMutex;
+        std::condition_variable doneSignal;
+
+        // Claims and casts one block; false once none are left
+        bool castNext() {
+            size_t block = nextBlock.fetch_add(1);
+            if (block >= blockCount) return false;
+
+            size_t end = std::min((block + 1) * BLOCK, order.size());
+            for (size_t i = block * BLOCK; i < end; ++i) {
+                const Terrain::Ray& ray = rays[order[i]];
+                Terrain::RayHit& hit = hits[order[i]];
+                auto point = terrain->raycast(ray.origin, ray.direction, ray.maxDistance);
+                hit.hit = point.has_value();
+                hit.point = point.value_or(glm::vec3(0.0f));
+                hit.distance = point ? glm::length(*point - ray.origin) : 0.0f;
+            }
+
+            if (doneBlocks.fetch_add(1) + 1 == blockCount) {
+                std::lock_guard<std::mutex> lock(doneMutex);
+                doneSignal.notify_one();
+            }
+            return true;
+        }
+    };
+}
+
+void Terrain::raycastBatch(const Ray* rays, size_t count, RayHit* hits) const
 {
-    std::vector<std::pair<int, int>> chunksToUnload;
-    
-    for (const auto& [coord, chunk] : chunks) {
-        int dx = coord.first - centerX;
-        int dz = coord.second - centerZ;
-        float distance = std::sqrt(dx * dx + dz * dz);
-        
-        if (distance > radius) {
-            chunksToUnload.push_back(coord);
+    PROFILE_SCOPE("Terrain::raycastBatch");
+    if (count == 0) return;
+
+    auto batch = std::make_shared<RayBatch>();
+    batch->terrain = this;
+    batch->rays = rays;
+    batch->hits = hits;
+    batch->blockCount = (count + RayBatch::BLOCK - 1) / RayBatch::BLOCK;
+
+    // Neighbouring rays then walk the same chunks and share their cache lines
+    const float size = static_cast<float>(ChunkConstants::SIZE);
+    std::vector<std::pair<uint64_t, uint32_t>> keyed(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto chunkX = static_cast<int32_t>(std::floor(rays[i].origin.x / size));
+        auto chunkZ = static_cast<int32_t>(std::floor(rays[i].origin.z / size));
+        uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(chunkZ)) << 32) | static_cast<uint32_t>(chunkX);
+        keyed[i] = {key, static_cast<uint32_t>(i)};
+    }
+    std::sort(keyed.begin(), keyed.end());
+    batch->order.reserve(count);
+    for (const auto& entry : keyed) {
+        batch->order.push_back(entry.second);
+    }
+
+    // The main thread casts too, so helpers only pay off past one block
+    const size_t helpers = std::min(impl->threadPool.getWorkerCount(), batch->blockCount - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        impl->threadPool.queueTask([batch] { while (batch->castNext()) {} });
+    }
+    while (batch->castNext()) {}
+
+    std::unique_lock<std::mutex> lock(batch->doneMutex);
+    batch->doneSignal.wait(lock, [&batch] { return batch->doneBlocks.load() == batch->blockCount; });
+}
+
+std::optional<glm::vec3> Terrain::raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance) const
+{
+    PROFILE_SCOPE("Terrain::raycast");
+    float length = glm::length(dir);
+    if (length <= 0.0f || maxDistance <= 0.0f) return std::nullopt;
+    const glm::vec3 unitDir = dir / length;
+
+    float hitT = 0.0f;
+    bool hit = walkGridXZ(origin, unitDir, 0.0f, maxDistance, static_cast<float>(ChunkConstants::SIZE),
+        [&](int chunkX, int chunkZ, float tEnter, float tExit) {
+            auto chunk = impl->chunkManager->findChunk(chunkX, chunkZ);
+            return chunk && chunk->raycast(origin, unitDir, tEnter, tExit, hitT);
+        });
+    if (!hit) return std::nullopt;
+    return origin + unitDir * hitT;
+}
+
+void Terrain::applyBrush(const BrushStroke& stroke)
+{
+    PROFILE_SCOPE("Terrain::applyBrush");
+    // Edited heights, not meshes: a stroke comes out the same however far remeshing has got
+    auto edits = TerrainBrush::computeEdits(stroke, [this](int x, int z) { return getEditedVertexHeight(x, z); });
+    if (edits.empty()) return;
+
+    uint64_t sequence = 0;
+    if (impl->editLog) {
+        sequence = impl->editLog->addEdits(edits);
+    } else {
+        std::lock_guard<std::mutex> lock(impl->unloggedMutex);
+        sequence = ++impl->editSequence;
+        for (const auto& edit : edits) {
+            impl->unloggedOffsets[{edit.vertexX, edit.vertexZ}] += edit.delta;
         }
     }
-    
-    for (const auto& coord : chunksToUnload) {
-        impl->chunkManager->unloadChunk(coord.first, coord.second);
-        chunks.erase(coord);
+
+    for (const auto& edit : edits) {
+        auto tile = impl->heightTiles.find({floorDiv(edit.vertexX, ChunkConstants::SIZE),
+                                            floorDiv(edit.vertexZ, ChunkConstants::SIZE)});
+        if (tile != impl->heightTiles.end()) tile->second.lastEdit = sequence;
+    }
+
+    std::unordered_map<std::pair<int, int>, std::vector<Chunk::VertexDelta>, ChunkPairHash> deltasByChunk;
+    for (const auto& edit : edits) {
+        TerrainEditLog::forEachSharingChunk(edit.vertexX, edit.vertexZ, [&](int chunkX, int chunkZ, int localX, int localZ) {
+            deltasByChunk[{chunkX, chunkZ}].push_back({localX, localZ, edit.delta});
+        });
+    }
+
+    // The edits above are already visible to getEditedVertexHeight; meshes follow on workers.
+    // Non-resident chunks pick the edits up from the log when they are generated
+    for (auto& [coord, deltas] : deltasByChunk) {
+        auto chunk = impl->chunkManager->findChunk(coord.first, coord.second);
+        if (!chunk) continue;
+        impl->threadPool.queueTask([chunk, deltas = std::move(deltas), sequence] {
+            chunk->applyHeightDeltas(deltas, sequence);
+        });
     }
 }
 
+std::map<std::pair<int, int>, std::shared_ptr<Chunk>> Terrain::getChunks() const {
+    std::map<std::pair<int, int>, std::shared_ptr<Chunk>> resident;
+    impl->chunkManager->forEachChunk([&resident](int x, int z, const std::shared_ptr<Chunk>& chunk) {
+        resident[{x, z}] = chunk;
+    });
+    return resident;
+}
+
+void Terrain::forEachLoadedChunk(const std::function<void(const std::shared_ptr<Chunk>&)>& fn) const {
+    impl->chunkManager->forEachChunk([&fn](int, int, const std::shared_ptr<Chunk>& chunk) {
+        fn(chunk);
+    });
+}
+
+std::vector<std::shared_ptr<Chunk>> Terrain::getVisibleChunks(float playerX, float playerZ) const {
+    std::vector<std::shared_ptr<Chunk>> visible;
+    impl->chunkManager->forEachChunk([&](int x, int z, const std::shared_ptr<Chunk>& chunk) {
+        float dist = glm::distance(glm::vec2(x * 16, z * 16), glm::vec2(playerX, playerZ));
+        if (dist <= TerrainConstants::TERRAIN_RENDER_DISTANCE) {
+            visible.push_back(chunk);
+        }
+    });
+    return visible;
+}
+
+void Terrain::updateChunks(float playerX, float playerZ)
+{
+    const int viewDistance = TerrainConstants::VIEW_DISTANCE;
+
+    // Only use ChunkManager to handle loading/unloading
+    impl->chunkManager->updateLoadedChunks(
+        glm::vec3(playerX, 0, playerZ),
+        viewDistance * ChunkConstants::SIZE
+    );
+
+    const auto& delta = impl->chunkManager->getLastUpdateDelta();
+    ++streamingStats.updates;
+    streamingStats.chunksLoaded += delta.loaded.size();
+    streamingStats.chunksUnloaded += delta.unloaded.size();
+}
+
 void Terrain::updateChunksAroundPlayer(float playerX, float playerZ)
 {
+    PROFILE_SCOPE("Terrain::updateChunksAroundPlayer");
     int currentChunkX = static_cast<int>(floor(playerX / ChunkConstants::SIZE));
     int currentChunkZ = static_cast<int>(floor(playerZ / ChunkConstants::SIZE));
 
@@ -219,6 +649,9 @@ void Terrain::updateChunksAroundPlayer(float playerX, float playerZ)
     // Or if we've moved to a new chunk
     needsUpdate |= (lastPlayerChunk.first != currentChunkX || lastPlayerChunk.second != currentChunkZ);
 
+    // Or if chunks in view were deferred by the budget or failed to load
+    needsUpdate |= impl->chunkManager->hasMissingChunks();
+
     if (needsUpdate)
     {
         updateChunks(playerX, playerZ);
@@ -228,15 +661,11 @@ void Terrain::updateChunksAroundPlayer(float playerX, float playerZ)
 
 bool Terrain::hasChunksOnAllSides(int chunkX, int chunkZ) const
 {
-    auto currentChunk = chunks.find({chunkX, chunkZ});
-    if (currentChunk == chunks.end())
-    {
-        // Current chunk doesn't exist; can't check neighbors reliably
-        return false;
-    }
-
-    return chunks.find({chunkX + 1, chunkZ}) != chunks.end() &&
-           chunks.find({chunkX - 1, chunkZ}) != chunks.end() &&
-           chunks.find({chunkX, chunkZ + 1}) != chunks.end() &&
-           chunks.find({chunkX, chunkZ - 1}) != chunks.end();
+    const ChunkManager& manager = *impl->chunkManager;
+    // Without the current chunk the neighbours can't be checked reliably
+    return manager.findChunk(chunkX, chunkZ) &&
+           manager.findChunk(chunkX + 1, chunkZ) &&
+           manager.findChunk(chunkX - 1, chunkZ) &&
+           manager.findChunk(chunkX, chunkZ + 1) &&
+           manager.findChunk(chunkX, chunkZ - 1);
 }
\ No newline at end of file
@@ -3,7 +3,12 @@
 
 #include <vector>
 #include <map>
+#include <memory_resource>
 #include <functional>
+#include <optional>
+#include <climits>
+#include <cstdint>
+#include <string>
 #include "BiomeManager.h"
 #include "Chunk.h"
 #include "IChunkFactory.h"
@@ -11,39 +16,111 @@
 #include "TerrainNoiseFactory.h"
 
 // Forward declarations
+struct BrushStroke;
+class ChunkCache;
 class ChunkManager;
+class TerrainEditLog;
 struct TerrainImpl;
 class TerrainThreadPool;
 
 class Terrain : public std::enable_shared_from_this<Terrain>
 {
 public:
+    struct Ray {
+        glm::vec3 origin;
+        glm::vec3 direction;  // Need not be normalized
+        float maxDistance = 100.0f;
+    };
+
+    struct RayHit {
+        bool hit = false;
+        glm::vec3 point{0.0f};
+        float distance = 0.0f;
+    };
+
+    // Running totals since construction, for replay and benchmark reports
+    struct StreamingStats {
+        uint64_t updates = 0;        // updateChunks calls that ran
+        uint64_t chunksLoaded = 0;
+        uint64_t chunksUnloaded = 0;
+    };
+
     explicit Terrain(TerrainThreadPool& threadPool);
     ~Terrain();
     
     static TerrainType getTerrainTypeAt(float worldX, float worldZ);
 
     float getHeightAt(float worldX, float worldZ);
+    // Height of the rendered surface: interpolated from the resident chunk's mesh, noise otherwise
+    float queryHeight(float worldX, float worldZ);
     void setChunkFactory(std::shared_ptr<IChunkFactory> factory);
 
-    const std::map<std::pair<int, int>, std::shared_ptr<Chunk>>& getChunks() const;
+    // Snapshot of the resident chunks keyed by coordinate; ChunkManager is the only residency index
+    std::map<std::pair<int, int>, std::shared_ptr<Chunk>> getChunks() const;
     std::vector<std::shared_ptr<Chunk>> getVisibleChunks(float playerX, float playerZ) const;
+    // Visit resident chunks in ChunkManager ring order (linear over memory)
+    void forEachLoadedChunk(const std::function<void(const std::shared_ptr<Chunk>&)>& fn) const;
 
     void initialize(std::shared_ptr<TerrainNoiseFactory> sharedNoiseFactory, std::function<void(float)> progressCallback);
     void updateChunksAroundPlayer(float playerX, float playerZ);
+    const StreamingStats& getStreamingStats() const { return streamingStats; }
     bool hasChunksOnAllSides(int chunkX, int chunkZ) const;
     std::shared_ptr<IChunkFactory> chunkFactory;
 
+    // On-disk heightfield cache; off unless enabled (opens once noise and biomes are set up)
+    void enableChunkCache(const std::string& directory);
+    bool loadCachedHeights(int chunkX, int chunkZ, std::pmr::vector<float>& heights);
+    void storeCachedHeights(int chunkX, int chunkZ, const std::pmr::vector<float>& heights);
+    ChunkCache* getChunkCache() const;
+    // Off: cached chunks are still read, but newly generated ones are not written back
+    void setChunkCacheWriteBack(bool enabled);
+
+    // Main-thread hook for chunks leaving residency; see ChunkManager::setUnloadCallback
+    void setChunkUnloadCallback(std::function<void(Chunk&)> callback);
+
+    // Byte budget for resident chunks (CPU + GPU); see ChunkManager
+    void setMemoryBudget(size_t bytes);
+    size_t getResidentChunkBytes() const;
+
+    // Persistent height edits (write-ahead logged); applied on top of generated heights.
+    // Without a log, edits are kept in memory for the session and applied the same way.
+    void enableEditLog(const std::string& directory);
+    bool applyHeightEdits(int chunkX, int chunkZ, std::pmr::vector<float>& heights, uint64_t* appliedSequence = nullptr);
+    TerrainEditLog* getEditLog() const;
+    // Logs the stroke's edits, then remeshes just the touched vertices of resident chunks on workers
+    void applyBrush(const BrushStroke& stroke);
+    // Current height of a grid vertex, edits included
+    float getVertexHeight(int vertexX, int vertexZ);
+
+    // Noise plus every edit applied so far; never reads chunk meshes, so the answer does not
+    // depend on what is resident or on whether remeshing has caught up. Served from per-tile
+    // caches that sample noise once and re-read offsets after an edit touches them. Main thread.
+    float getEditedVertexHeight(int vertexX, int vertexZ);
+    // Surface through getEditedVertexHeight with the meshes' triangle split; what Simulation stands on
+    float sampleEditedHeight(float worldX, float worldZ);
+    // First point along dir where the ray drops below sampleEditedHeight; residency-independent
+    // counterpart of raycast() for the simulation, marching the cached edited heights
+    std::optional<glm::vec3> raycastEdited(const glm::vec3& origin, const glm::vec3& dir, float maxDistance);
+
+    // First hit against resident chunk meshes within maxDistance along dir; walks the chunk
+    // grid with a DDA and never samples noise, so rays leaving the resident area miss
+    std::optional<glm::vec3> raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance) const;
+    // Main thread: casts every ray, hits[i] answering rays[i]. Rays are grouped by starting chunk and
+    // shared with the thread pool in blocks; the call returns once all of them are done.
+    void raycastBatch(const Ray* rays, size_t count, RayHit* hits) const;
+
 private:
     void initializeChunkManager();
-    void loadChunk(int chunkX, int chunkZ);
-    void unloadFarChunks(int centerX, int centerZ, int radius);
+    void openChunkCache();
+    // Fans generation of the (2r+1)^2 spawn chunks out over the pool and uploads them as they finish
+    void generateSpawnArea(int radius, const std::function<void(float)>& progressCallback);
     void updateChunks(float playerX, float playerZ);
+    float getEditOffset(int vertexX, int vertexZ);
 
-    std::map<std::pair<int, int>, std::shared_ptr<Chunk>> chunks;
     std::shared_ptr<TerrainNoiseFactory> noiseFactory;
     std::unique_ptr<TerrainImpl> impl;
     std::pair<int, int> lastPlayerChunk = { INT_MIN, INT_MIN };
+    StreamingStats streamingStats;
 };
 
 #endif
\ No newline at end of file
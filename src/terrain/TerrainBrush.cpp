@@ -0,0 +1,69 @@
+#include "TerrainBrush.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr float CRATER_BOWL = 0.75f;  // Fraction of the radius that is dug out; the rest is rim
+    constexpr float CRATER_RIM_HEIGHT = 0.3f;
+}
+
+float TerrainBrush::falloff(float distance, float radius) {
+    if (radius <= 0.0f || distance >= radius) return 0.0f;
+    float t = 1.0f - distance / radius;
+    return t * t * (3.0f - 2.0f * t);
+}
+
+std::vector<TerrainEditLog::HeightEdit> TerrainBrush::computeEdits(const BrushStroke& stroke,
+                                                                   const HeightSampler& sampleHeight) {
+    std::vector<TerrainEditLog::HeightEdit> edits;
+    if (stroke.radius <= 0.0f || stroke.strength == 0.0f) return edits;
+
+    int minX = static_cast<int>(std::ceil(stroke.centerX - stroke.radius));
+    int maxX = static_cast<int>(std::floor(stroke.centerX + stroke.radius));
+    int minZ = static_cast<int>(std::ceil(stroke.centerZ - stroke.radius));
+    int maxZ = static_cast<int>(std::floor(stroke.centerZ + stroke.radius));
+    edits.reserve(static_cast<size_t>(maxX - minX + 1) * (maxZ - minZ + 1));
+
+    for (int z = minZ; z <= maxZ; ++z) {
+        for (int x = minX; x <= maxX; ++x) {
+            float dx = static_cast<float>(x) - stroke.centerX;
+            float dz = static_cast<float>(z) - stroke.centerZ;
+            float distance = std::sqrt(dx * dx + dz * dz);
+            if (distance >= stroke.radius) continue;
+
+            float delta = 0.0f;
+            switch (stroke.mode) {
+            case BrushMode::Raise:
+                delta = stroke.strength * falloff(distance, stroke.radius);
+                break;
+            case BrushMode::Lower:
+                delta = -stroke.strength * falloff(distance, stroke.radius);
+                break;
+            case BrushMode::Smooth: {
+                if (!sampleHeight) break;
+                float average = (sampleHeight(x - 1, z) + sampleHeight(x + 1, z) +
+                                 sampleHeight(x, z - 1) + sampleHeight(x, z + 1)) * 0.25f;
+                float blend = std::clamp(stroke.strength, 0.0f, 1.0f) * falloff(distance, stroke.radius);
+                delta = (average - sampleHeight(x, z)) * blend;
+                break;
+            }
+            case BrushMode::Crater: {
+                float t = distance / stroke.radius;
+                if (t < CRATER_BOWL) {
+                    float u = t / CRATER_BOWL;
+                    delta = -stroke.strength * (1.0f - u * u);
+                } else {
+                    float u = (t - CRATER_BOWL) / (1.0f - CRATER_BOWL);
+                    delta = stroke.strength * CRATER_RIM_HEIGHT * std::sin(u * 3.14159265f);
+                }
+                break;
+            }
+            }
+
+            if (delta != 0.0f) {
+                edits.push_back({x, z, delta});
+            }
+        }
+    }
+    return edits;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+#include "TerrainEditLog.h"
+
+enum class BrushMode {
+    Raise,
+    Lower,
+    Smooth,   // Pulls each vertex toward the average of its neighbours
+    Crater    // Bowl with a raised rim, as left behind by a lifted glob
+};
+
+struct BrushStroke {
+    BrushMode mode = BrushMode::Raise;
+    float centerX = 0.0f;  // World units
+    float centerZ = 0.0f;
+    float radius = 3.0f;
+    float strength = 1.0f; // Height units at the centre (Smooth: blend factor, 0..1)
+};
+
+// Turns a stroke into per-vertex height deltas. Pure: the caller supplies current
+// heights (only Smooth reads them) and decides where the edits go.
+class TerrainBrush {
+public:
+    using HeightSampler = std::function<float(int vertexX, int vertexZ)>;
+
+    static std::vector<TerrainEditLog::HeightEdit> computeEdits(const BrushStroke& stroke,
+                                                                const HeightSampler& sampleHeight);
+    // Smooth radial weight: 1 at the centre, 0 at the radius
+    static float falloff(float distance, float radius);
+};
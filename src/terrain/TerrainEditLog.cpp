@@ -0,0 +1,415 @@
+#include "TerrainEditLog.h"
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include "ChunkConstants.h"
+#include "Debug.h"
+
+namespace {
+    constexpr char LOG_MAGIC[4] = {'T', 'W', 'A', 'L'};
+    constexpr uint32_t LOG_VERSION = 1;
+    constexpr size_t LOG_HEADER_SIZE = 16;  // magic + version + worldKey
+    constexpr int SIZE = ChunkConstants::SIZE;
+    constexpr uint32_t GRID = SIZE + 1;
+
+    struct LogRecord {
+        int32_t vertexX;
+        int32_t vertexZ;
+        float offset;
+        uint32_t checksum;
+    };
+    static_assert(sizeof(LogRecord) == 16, "LogRecord must stay tightly packed");
+
+    uint32_t recordChecksum(const LogRecord& record) {
+        uint32_t hash = 2166136261u;
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&record);
+        for (size_t i = 0; i < offsetof(LogRecord, checksum); ++i) {
+            hash = (hash ^ bytes[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    int floorDiv(int value, int divisor) {
+        return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+    }
+
+    uint64_t chunkKey(int chunkX, int chunkZ) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkZ);
+    }
+
+    int keyX(uint64_t key) { return static_cast<int32_t>(key >> 32); }
+    int keyZ(uint64_t key) { return static_cast<int32_t>(key & 0xFFFFFFFFu); }
+}
+
+TerrainEditLog::TerrainEditLog(const std::string& rootDirectory, uint64_t worldKey)
+    : worldKey(worldKey)
+{
+    std::ostringstream dir;
+    dir << rootDirectory << "/" << std::hex << worldKey;
+    directory = dir.str();
+    logPath = directory + "/edits.wal";
+    segmentPath = logPath + ".1";
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        Debug::logError("[TerrainEditLog] Unable to create " + directory + ": " + ec.message());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        replayLog();
+    }
+    compactor = std::thread([this] { compactorLoop(); });
+}
+
+TerrainEditLog::~TerrainEditLog() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    compactorWake.notify_one();
+    compactor.join();  // Finishes a compaction already requested
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (pendingRecords > 0 && beginCompactionLocked()) {
+        runCompaction(lock);
+    }
+}
+
+void TerrainEditLog::replayLog() {
+    // A segment left by an unfinished compaction comes first; the log continues it
+    std::error_code ec;
+    size_t replayed = 0;
+    if (std::filesystem::exists(segmentPath, ec) && !replayFile(segmentPath, replayed)) {
+        std::filesystem::remove(segmentPath, ec);
+    }
+    bool logValid = replayFile(logPath, replayed);
+
+    pendingRecords = replayed;
+    if (replayed > 0) {
+        Debug::log("[TerrainEditLog] Replayed " + std::to_string(replayed) + " edits from " + directory);
+    }
+    openLog(!logValid);
+}
+
+bool TerrainEditLog::replayFile(const std::string& path, size_t& replayed) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    char header[LOG_HEADER_SIZE] = {};
+    in.read(header, sizeof(header));
+    uint32_t version = 0;
+    uint64_t key = 0;
+    std::memcpy(&version, header + 4, 4);
+    std::memcpy(&key, header + 8, 8);
+    if (!in || std::memcmp(header, LOG_MAGIC, 4) != 0 || version != LOG_VERSION || key != worldKey) {
+        Debug::logError("[TerrainEditLog] Discarding unreadable log " + path);
+        return false;
+    }
+
+    // Stop at the first torn or corrupt record; everything after it is unreliable
+    size_t count = 0;
+    LogRecord record{};
+    while (in.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        if (record.checksum != recordChecksum(record)) break;
+        setOffset(record.vertexX, record.vertexZ, record.offset);
+        ++count;
+    }
+    in.close();
+
+    std::error_code ec;
+    uintmax_t validSize = LOG_HEADER_SIZE + count * sizeof(LogRecord);
+    if (std::filesystem::file_size(path, ec) != validSize && !ec) {
+        Debug::log("[TerrainEditLog] Dropping torn tail of " + path + " after " + std::to_string(count) + " records");
+        std::filesystem::resize_file(path, validSize, ec);
+    }
+    replayed += count;
+    return true;
+}
+
+void TerrainEditLog::openLog(bool truncate) {
+    if (log.is_open()) {
+        log.close();
+    }
+
+    if (truncate) {
+        char header[LOG_HEADER_SIZE] = {};
+        std::memcpy(header, LOG_MAGIC, 4);
+        std::memcpy(header + 4, &LOG_VERSION, 4);
+        std::memcpy(header + 8, &worldKey, 8);
+        std::ofstream create(logPath, std::ios::binary | std::ios::trunc);
+        create.write(header, sizeof(header));
+    }
+
+    log.open(logPath, std::ios::binary | std::ios::app);
+    if (!log.is_open()) {
+        Debug::logError("[TerrainEditLog] Unable to open " + logPath);
+    }
+}
+
+uint64_t TerrainEditLog::addEdit(int vertexX, int vertexZ, float delta) {
+    return addEdits({{vertexX, vertexZ, delta}});
+}
+
+uint64_t TerrainEditLog::addEdits(const std::vector<HeightEdit>& edits) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (edits.empty()) return sequence;
+
+    for (const HeightEdit& edit : edits) {
+        LogRecord record{edit.vertexX, edit.vertexZ, currentOffset(edit.vertexX, edit.vertexZ) + edit.delta, 0};
+        record.checksum = recordChecksum(record);
+        log.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        setOffset(record.vertexX, record.vertexZ, record.offset);
+    }
+    log.flush();
+    pendingRecords += edits.size();
+
+    if (pendingRecords >= nextCompactAt && beginCompactionLocked()) {
+        compactRequested = true;
+        compactorWake.notify_one();
+    }
+    return ++sequence;
+}
+
+void TerrainEditLog::setOffset(int vertexX, int vertexZ, float offset) {
+    forEachSharingChunk(vertexX, vertexZ, [&](int chunkX, int chunkZ, int localX, int localZ) {
+        uint64_t key = chunkKey(chunkX, chunkZ);
+        auto it = dirty.find(key);
+        if (it == dirty.end()) {
+            // First edit since compaction: start from the newest compacted state
+            it = dirty.emplace(key, Overlay{}).first;
+            auto snapshot = compacting.find(key);
+            if (snapshot != compacting.end()) {
+                it->second = snapshot->second;
+            } else {
+                readCompacted(chunkX, chunkZ, it->second);
+            }
+        }
+
+        uint32_t index = static_cast<uint32_t>(localZ) * GRID + localX;
+        if (offset == 0.0f) {
+            it->second.erase(index);
+        } else {
+            it->second[index] = offset;
+        }
+    });
+}
+
+float TerrainEditLog::currentOffset(int vertexX, int vertexZ) {
+    int chunkX = floorDiv(vertexX, SIZE);
+    int chunkZ = floorDiv(vertexZ, SIZE);
+    uint32_t index = static_cast<uint32_t>(vertexZ - chunkZ * SIZE) * GRID + (vertexX - chunkX * SIZE);
+
+    if (const Overlay* overlay = findUncompacted(chunkKey(chunkX, chunkZ))) {
+        auto offset = overlay->find(index);
+        return offset != overlay->end() ? offset->second : 0.0f;
+    }
+
+    Overlay compacted;
+    readCompacted(chunkX, chunkZ, compacted);
+    auto offset = compacted.find(index);
+    return offset != compacted.end() ? offset->second : 0.0f;
+}
+
+float TerrainEditLog::getOffset(int vertexX, int vertexZ) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return currentOffset(vertexX, vertexZ);
+}
+
+bool TerrainEditLog::applyOverlay(int chunkX, int chunkZ, std::pmr::vector<float>& heights, uint64_t* appliedSequence) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (appliedSequence) {
+        *appliedSequence = sequence;
+    }
+
+    Overlay compacted;
+    const Overlay* overlay = findUncompacted(chunkKey(chunkX, chunkZ));
+    if (!overlay) {
+        if (!readCompacted(chunkX, chunkZ, compacted)) return false;
+        overlay = &compacted;
+    }
+
+    for (const auto& [index, offset] : *overlay) {
+        if (index < heights.size()) {
+            heights[index] += offset;
+        }
+    }
+    return !overlay->empty();
+}
+
+const TerrainEditLog::Overlay* TerrainEditLog::findUncompacted(uint64_t key) const {
+    auto it = dirty.find(key);
+    if (it != dirty.end()) return &it->second;
+    auto snapshot = compacting.find(key);
+    return snapshot != compacting.end() ? &snapshot->second : nullptr;
+}
+
+bool TerrainEditLog::readCompacted(int chunkX, int chunkZ, Overlay& overlay) {
+    int localX = 0, localZ = 0;
+    RegionFile& region = regionFor(chunkX, chunkZ, localX, localZ);
+
+    // Payload: u32 count, then count x { u32 index, f32 offset }
+    return region.read(localX, localZ, [&overlay](const uint8_t* data, size_t size) {
+        uint32_t count = 0;
+        if (size < 4) return false;
+        std::memcpy(&count, data, 4);
+        if (size != 4 + static_cast<size_t>(count) * 8) return false;
+
+        overlay.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t index = 0;
+            float offset = 0.0f;
+            std::memcpy(&index, data + 4 + i * 8, 4);
+            std::memcpy(&offset, data + 8 + i * 8, 4);
+            overlay[index] = offset;
+        }
+        return count > 0;
+    });
+}
+
+RegionFile& TerrainEditLog::regionFor(int chunkX, int chunkZ, int& localX, int& localZ) {
+    int regionX = floorDiv(chunkX, RegionFile::REGION_SIZE);
+    int regionZ = floorDiv(chunkZ, RegionFile::REGION_SIZE);
+    localX = chunkX - regionX * RegionFile::REGION_SIZE;
+    localZ = chunkZ - regionZ * RegionFile::REGION_SIZE;
+
+    auto& region = regions[chunkKey(regionX, regionZ)];
+    if (!region) {
+        std::string path = directory + "/e." + std::to_string(regionX) + "." + std::to_string(regionZ) + ".trg";
+        region = std::make_unique<RegionFile>(path, worldKey);
+    }
+    return *region;
+}
+
+void TerrainEditLog::compact() {
+    std::unique_lock<std::mutex> lock(mutex);
+    compactionDone.wait(lock, [this] { return !compactionInFlight; });
+    if (beginCompactionLocked()) {
+        runCompaction(lock);
+    }
+}
+
+bool TerrainEditLog::rotateLogLocked() {
+    log.close();
+    std::error_code ec;
+    bool rotated = true;
+    if (!std::filesystem::exists(segmentPath, ec)) {
+        std::filesystem::rename(logPath, segmentPath, ec);
+        rotated = !ec;
+    } else {
+        // An earlier compaction failed; its segment still holds records the regions lack
+        std::ifstream in(logPath, std::ios::binary);
+        std::ofstream out(segmentPath, std::ios::binary | std::ios::app);
+        in.seekg(LOG_HEADER_SIZE);
+        char buffer[4096];
+        while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0) {
+            out.write(buffer, in.gcount());
+        }
+        out.flush();
+        rotated = in.is_open() && out.good();
+    }
+
+    if (!rotated) {
+        Debug::logError("[TerrainEditLog] Unable to move " + logPath + " aside for compaction");
+        openLog(false);
+        return false;
+    }
+    openLog(true);
+    return true;
+}
+
+bool TerrainEditLog::beginCompactionLocked() {
+    if (compactionInFlight || dirty.empty()) return false;
+    if (!rotateLogLocked()) {
+        nextCompactAt = pendingRecords + COMPACT_THRESHOLD;
+        return false;
+    }
+
+    compacting = std::move(dirty);
+    dirty.clear();
+    compactingRecords = pendingRecords;
+    compactionInFlight = true;
+    return true;
+}
+
+void TerrainEditLog::runCompaction(std::unique_lock<std::mutex>& lock) {
+    struct Target {
+        uint64_t key;
+        RegionFile* region;
+        int localX, localZ;
+    };
+    std::vector<Target> targets;
+    targets.reserve(compacting.size());
+    for (const auto& entry : compacting) {
+        Target target{entry.first, nullptr, 0, 0};
+        target.region = &regionFor(keyX(entry.first), keyZ(entry.first), target.localX, target.localZ);
+        targets.push_back(target);
+    }
+    lock.unlock();
+
+    std::vector<uint64_t> failed;
+    std::vector<uint8_t> payload;
+    for (const Target& target : targets) {
+        const Overlay& overlay = compacting.find(target.key)->second;
+        payload.resize(4 + overlay.size() * 8);
+        uint32_t count = static_cast<uint32_t>(overlay.size());
+        std::memcpy(payload.data(), &count, 4);
+        size_t pos = 4;
+        for (const auto& [index, offset] : overlay) {
+            std::memcpy(payload.data() + pos, &index, 4);
+            std::memcpy(payload.data() + pos + 4, &offset, 4);
+            pos += 8;
+        }
+
+        if (!target.region->write(target.localX, target.localZ, payload.data(), payload.size())) {
+            failed.push_back(target.key);
+        }
+    }
+
+    lock.lock();
+    // Failed chunks go back to dirty unless an edit since the snapshot already copied them there
+    for (uint64_t key : failed) {
+        auto snapshot = compacting.find(key);
+        dirty.emplace(key, std::move(snapshot->second));
+    }
+
+    std::error_code ec;
+    if (failed.empty()) {
+        Debug::log("[TerrainEditLog] Compacted " + std::to_string(compactingRecords) + " edits across " +
+                   std::to_string(compacting.size()) + " chunks");
+        std::filesystem::remove(segmentPath, ec);
+        pendingRecords -= compactingRecords;
+        nextCompactAt = COMPACT_THRESHOLD;
+    } else {
+        // Keep the segment: it still holds everything needed to retry, which waits for more edits
+        Debug::logError("[TerrainEditLog] Compaction failed for " + std::to_string(failed.size()) + " of " +
+                        std::to_string(compacting.size()) + " chunks");
+        nextCompactAt = pendingRecords + COMPACT_THRESHOLD;
+    }
+    compacting.clear();
+    compactingRecords = 0;
+    compactionInFlight = false;
+    compactionDone.notify_all();
+}
+
+void TerrainEditLog::compactorLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        compactorWake.wait(lock, [this] { return compactRequested || stopping; });
+        if (compactRequested) {
+            compactRequested = false;
+            runCompaction(lock);
+            continue;
+        }
+        return;
+    }
+}
+
+size_t TerrainEditLog::getPendingRecordCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pendingRecords;
+}
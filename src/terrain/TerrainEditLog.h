@@ -0,0 +1,121 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ChunkConstants.h"
+#include "RegionFile.h"
+
+// Sparse per-chunk height offsets layered on top of generated terrain.
+//
+// Edits are addressed by world vertex (chunk grids share their border rows, so
+// one vertex can belong to up to four chunks). Every edit is appended to a
+// write-ahead log before it is applied in memory; once enough records pile up
+// the dirty chunks are compacted into region files and the log is truncated.
+// Compaction runs on the log's own thread: the log is renamed to a segment
+// (edits.wal.1) and a fresh one takes new edits while the snapshot is written,
+// so addEdits never waits on region IO. A failed compaction keeps the segment
+// and later logs are appended to it until one succeeds.
+// Log records carry the resulting absolute offset rather than the increment,
+// so replaying a log that was already partly compacted is harmless.
+class TerrainEditLog {
+public:
+    struct HeightEdit {
+        int vertexX;
+        int vertexZ;
+        float delta;  // Added to the vertex's current offset
+    };
+
+    static constexpr size_t COMPACT_THRESHOLD = 4096;  // Log records between compactions
+
+    TerrainEditLog(const std::string& rootDirectory, uint64_t worldKey);
+    ~TerrainEditLog();
+
+    TerrainEditLog(const TerrainEditLog&) = delete;
+    TerrainEditLog& operator=(const TerrainEditLog&) = delete;
+
+    // Both return the edit sequence number of the batch (increments per call)
+    uint64_t addEdit(int vertexX, int vertexZ, float delta);
+    // Logs the whole batch with a single flush
+    uint64_t addEdits(const std::vector<HeightEdit>& edits);
+
+    // Adds the chunk's offsets to a (SIZE + 1)^2 heightfield; false if the chunk is unedited.
+    // appliedSequence receives the last batch included, so callers can skip older in-flight deltas.
+    bool applyOverlay(int chunkX, int chunkZ, std::pmr::vector<float>& heights, uint64_t* appliedSequence = nullptr);
+    float getOffset(int vertexX, int vertexZ);
+
+    // Folds logged edits into the region files and truncates the log; waits for a
+    // background compaction in flight and runs this one on the calling thread
+    void compact();
+
+    size_t getPendingRecordCount() const;
+
+    // Calls fn(chunkX, chunkZ, localX, localZ) for each chunk whose grid holds the vertex
+    template <typename Fn>
+    static void forEachSharingChunk(int vertexX, int vertexZ, Fn&& fn) {
+        constexpr int SIZE = ChunkConstants::SIZE;
+        int ownerX = vertexX >= 0 ? vertexX / SIZE : (vertexX - SIZE + 1) / SIZE;
+        int ownerZ = vertexZ >= 0 ? vertexZ / SIZE : (vertexZ - SIZE + 1) / SIZE;
+        int localX = vertexX - ownerX * SIZE;
+        int localZ = vertexZ - ownerZ * SIZE;
+
+        // A vertex on a chunk border also lives in the last row/column of the previous chunk
+        for (int dz = 0; dz <= (localZ == 0 ? 1 : 0); ++dz) {
+            for (int dx = 0; dx <= (localX == 0 ? 1 : 0); ++dx) {
+                fn(ownerX - dx, ownerZ - dz, localX + dx * SIZE, localZ + dz * SIZE);
+            }
+        }
+    }
+    const std::string& getDirectory() const { return directory; }
+
+private:
+    using Overlay = std::unordered_map<uint32_t, float>;  // Vertex index in the chunk grid -> offset
+
+    void replayLog();
+    // Applies every intact record and cuts off a torn tail; false if the file is missing or not a log
+    bool replayFile(const std::string& path, size_t& replayed);
+    void openLog(bool truncate);
+    // Moves the log's records into the segment and starts a fresh log
+    bool rotateLogLocked();
+    void setOffset(int vertexX, int vertexZ, float offset);
+    float currentOffset(int vertexX, int vertexZ);
+    // Newest uncompacted overlay for the chunk (dirty, then the snapshot being written)
+    const Overlay* findUncompacted(uint64_t key) const;
+    bool readCompacted(int chunkX, int chunkZ, Overlay& overlay);
+    RegionFile& regionFor(int chunkX, int chunkZ, int& localX, int& localZ);
+    // Snapshots dirty into compacting after a rotation; false if there is nothing to do or one is in flight
+    bool beginCompactionLocked();
+    // Writes the snapshot with the mutex released; lock is held again on return
+    void runCompaction(std::unique_lock<std::mutex>& lock);
+    void compactorLoop();
+
+    std::string directory;
+    std::string logPath;
+    std::string segmentPath;  // Records of the compaction in flight (or a failed one)
+    uint64_t worldKey;
+
+    mutable std::mutex mutex;
+    std::ofstream log;
+    size_t pendingRecords = 0;  // Records in the segment and the log
+    size_t nextCompactAt = COMPACT_THRESHOLD;
+    uint64_t sequence = 0;
+    std::unordered_map<uint64_t, Overlay> dirty;  // Chunks with edits not yet compacted
+    // Read-only while a compaction is in flight, so the compactor reads it without the mutex
+    std::unordered_map<uint64_t, Overlay> compacting;
+    size_t compactingRecords = 0;
+    bool compactionInFlight = false;
+    bool compactRequested = false;
+    bool stopping = false;
+    std::condition_variable compactorWake;
+    std::condition_variable compactionDone;
+    // Map nodes are stable, so the compactor keeps RegionFile pointers after releasing the mutex
+    std::unordered_map<uint64_t, std::unique_ptr<RegionFile>> regions;
+    std::thread compactor;  // Started last, once every member above exists
+};
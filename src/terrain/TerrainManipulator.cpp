@@ -1,38 +1,96 @@
 #include "TerrainManipulator.h"
-#include <iostream>
+#include <algorithm>
+#include <cstring>
 #include <glm/gtx/string_cast.hpp>
+#include "Debug.h"
+#include "TerrainBrush.h"
+
+namespace {
+    // Uniform in [-0.5, 0.5)
+    float nextWobble(uint32_t& state) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return static_cast<float>(state >> 8) / static_cast<float>(1u << 24) - 0.5f;
+    }
+
+    uint64_t mixBytes(uint64_t hash, const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+}
 
 void TerrainManipulator::initialize(std::shared_ptr<Terrain> terrainPtr) {
     terrain = terrainPtr;
 }
 
 void TerrainManipulator::beginLift(const glm::vec3& worldPosition) {
-    std::cout << "[TerrainManipulator] Lifting terrain at: " << glm::to_string(worldPosition) << std::endl;
+    Debug::log("[TerrainManipulator] Lifting terrain at: " + glm::to_string(worldPosition));
 
-    auto glob = std::make_unique<EarthGlob>();
-    glob->initialize(worldPosition);
-    activeGlobs.push_back(std::move(glob));
+    // Seeded from the id so a replay wobbles the same way
+    uint32_t id = nextGlobId++;
+    activeGlobs.push_back({id, worldPosition, glm::vec3(0.0f, LIFT_SPEED, 0.0f), 0x9e3779b9u ^ (id * 0x85ebca6bu)});
 
-    // TODO: Deform terrain by creating a crater/hole
-    // This would involve modifying the terrain height data
-    // and regenerating the affected chunks
+    // Leave a crater where the glob came from
+    if (terrain) {
+        terrain->applyBrush({BrushMode::Crater, worldPosition.x, worldPosition.z, CRATER_RADIUS, CRATER_DEPTH});
+        digSites.push_back({worldPosition, DIG_DURATION});
+    }
 }
 
 void TerrainManipulator::update(float deltaTime) {
-    for (auto it = activeGlobs.begin(); it != activeGlobs.end();) {
-        (*it)->update(deltaTime);
-        
-        glm::vec3 pos = (*it)->getPosition();
-        if (pos.y > 100.0f) { // Example height limit
-            it = activeGlobs.erase(it);
+    // Small strokes every step; each one only remeshes the rows it touches
+    for (auto it = digSites.begin(); it != digSites.end();) {
+        float step = std::min(deltaTime, it->timeLeft);
+        terrain->applyBrush({BrushMode::Lower, it->position.x, it->position.z, CRATER_RADIUS * 0.75f, DIG_RATE * step});
+        it->timeLeft -= step;
+        if (it->timeLeft <= 0.0f) {
+            it = digSites.erase(it);
         } else {
             ++it;
         }
     }
+
+    const float wobbleAmount = 0.1f;
+    const float maxHorizontalSpeed = 2.0f;
+    for (Glob& glob : activeGlobs) {
+        glob.position += glob.velocity * deltaTime;
+
+        glob.velocity.x += nextWobble(glob.rng) * wobbleAmount;
+        glob.velocity.z += nextWobble(glob.rng) * wobbleAmount;
+        glm::vec2 horizontalVel(glob.velocity.x, glob.velocity.z);
+        if (glm::length(horizontalVel) > maxHorizontalSpeed) {
+            horizontalVel = glm::normalize(horizontalVel) * maxHorizontalSpeed;
+            glob.velocity.x = horizontalVel.x;
+            glob.velocity.z = horizontalVel.y;
+        }
+    }
+
+    activeGlobs.erase(std::remove_if(activeGlobs.begin(), activeGlobs.end(),
+                                     [](const Glob& glob) { return glob.position.y > MAX_GLOB_HEIGHT; }),
+                      activeGlobs.end());
+}
+
+void TerrainManipulator::getGlobs(std::vector<GlobState>& out) const {
+    out.clear();
+    for (const Glob& glob : activeGlobs) {
+        out.push_back({glob.id, glob.position});
+    }
 }
 
-void TerrainManipulator::render(const glm::mat4& view, const glm::mat4& projection) {
-    for (const auto& glob : activeGlobs) {
-        glob->render(view, projection);
+uint64_t TerrainManipulator::hashState(uint64_t hash) const {
+    for (const Glob& glob : activeGlobs) {
+        hash = mixBytes(hash, &glob.id, sizeof(glob.id));
+        hash = mixBytes(hash, &glob.position, sizeof(glob.position));
+        hash = mixBytes(hash, &glob.velocity, sizeof(glob.velocity));
+        hash = mixBytes(hash, &glob.rng, sizeof(glob.rng));
+    }
+    for (const DigSite& site : digSites) {
+        hash = mixBytes(hash, &site.timeLeft, sizeof(site.timeLeft));
     }
+    return hash;
 }
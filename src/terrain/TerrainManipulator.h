@@ -1,18 +1,51 @@
 #pragma once
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <memory>
 #include <vector>
 #include "Terrain.h"
-#include "EarthGlob.h"
 
+// Earth-glob lifting: craters the terrain and flies the glob upward.
+// Pure simulation state stepped by Simulation; the renderer draws the globs.
 class TerrainManipulator {
 public:
+    struct GlobState {
+        uint32_t id;
+        glm::vec3 position;
+    };
+
     void initialize(std::shared_ptr<Terrain> terrain);
     void beginLift(const glm::vec3& worldPosition); // Called after 3s hold
     void update(float deltaTime);
-    void render(const glm::mat4& view, const glm::mat4& projection);
+
+    // Ascending id, oldest first
+    void getGlobs(std::vector<GlobState>& out) const;
+    // Folds glob positions, velocities and random state into an FNV-1a hash
+    uint64_t hashState(uint64_t hash) const;
 
 private:
+    // Where a glob was pulled out; keeps deepening for a short while after the lift
+    struct DigSite {
+        glm::vec3 position;
+        float timeLeft;
+    };
+
+    struct Glob {
+        uint32_t id;
+        glm::vec3 position;
+        glm::vec3 velocity;
+        uint32_t rng;  // xorshift32 for the wobble; rand() would break replays
+    };
+
+    static constexpr float CRATER_RADIUS = 3.0f;
+    static constexpr float CRATER_DEPTH = 1.0f;
+    static constexpr float DIG_DURATION = 0.75f;  // Seconds of per-step digging after a lift
+    static constexpr float DIG_RATE = 1.5f;       // Extra depth per second while digging
+    static constexpr float LIFT_SPEED = 1.5f;
+    static constexpr float MAX_GLOB_HEIGHT = 100.0f;
+
     std::shared_ptr<Terrain> terrain;
-    std::vector<std::unique_ptr<EarthGlob>> activeGlobs;
+    std::vector<Glob> activeGlobs;
+    std::vector<DigSite> digSites;
+    uint32_t nextGlobId = 1;
 };
@@ -48,3 +48,16 @@ std::function<float(float, float)> TerrainNoiseFactory::getNoise(TerrainType typ
               << static_cast<int>(type) << std::endl;
     return [](float, float) { return 0.0f; };
 }
+
+uint64_t TerrainNoiseFactory::getConfigHash() const {
+    uint64_t hash = 1469598103934665603ULL;
+    for (int i = 0; i < static_cast<int>(TerrainType::Count); ++i) {
+        auto it = noiseInstances.find(static_cast<TerrainType>(i));
+        if (it == noiseInstances.end()) continue;
+
+        if (auto* configurable = dynamic_cast<const ConfigurableNoise*>(it->second.get())) {
+            hash ^= configurable->getConfig().hash() + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        }
+    }
+    return hash;
+}
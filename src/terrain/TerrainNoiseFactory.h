@@ -3,6 +3,7 @@
 #include <unordered_map>
 #include <functional>
 #include <memory>
+#include <cstdint>
 #include "TerrainType.h"
 #include "BaseNoise.h"
 
@@ -17,6 +18,9 @@ public:
 
     std::function<float(float, float)> getNoise(TerrainType type) const;
 
+    // Combined hash of every terrain type's NoiseConfig
+    uint64_t getConfigHash() const;
+
 private:
     std::unordered_map<TerrainType, std::function<float(float, float)>> heightFunctions;
     std::unordered_map<TerrainType, std::unique_ptr<BaseNoise>> noiseInstances;
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <sstream>
+#include "AsyncLogger.h"
+#include "Debug.h"
+
+TEST(AsyncLoggerTest, RateLimitsChattyLevelsButNeverErrors) {
+    AsyncLogger& logger = AsyncLogger::getInstance();
+    logger.flush();
+
+    // Capture the writer's output; swapping is safe once the queue is drained
+    std::ostringstream out, err;
+    std::streambuf* oldOut = std::cout.rdbuf(out.rdbuf());
+    std::streambuf* oldErr = std::cerr.rdbuf(err.rdbuf());
+
+    uint64_t droppedBefore = logger.getDroppedCount();
+    // Three budgets' worth can straddle at most one second boundary, so at least one budget is dropped
+    int accepted = 0;
+    for (uint32_t i = 0; i < AsyncLogger::MAX_RECORDS_PER_SECOND * 3; ++i) {
+        accepted += logger.push(AsyncLogger::Level::Info, "spam " + std::to_string(i)) ? 1 : 0;
+    }
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_TRUE(logger.push(AsyncLogger::Level::Error, "error " + std::to_string(i)));
+    }
+    Debug::flushLog();
+
+    std::cout.rdbuf(oldOut);
+    std::cerr.rdbuf(oldErr);
+
+    EXPECT_LE(accepted, static_cast<int>(AsyncLogger::MAX_RECORDS_PER_SECOND * 2));
+    EXPECT_GE(logger.getDroppedCount() - droppedBefore, AsyncLogger::MAX_RECORDS_PER_SECOND);
+    EXPECT_NE(out.str().find("INFO: spam 0"), std::string::npos);
+    EXPECT_NE(err.str().find("ERROR: error 15"), std::string::npos);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include "InputRecording.h"
+#include "MockChunkFactory.h"
+#include "Simulation.h"
+#include "Terrain.h"
+#include "TerrainNoiseFactory.h"
+#include "../mocks/MockTerrainThreadPool.h"
+
+namespace {
+    struct HeadlessWorld {
+        MockTerrainThreadPool threadPool;
+        std::shared_ptr<Terrain> terrain;
+
+        HeadlessWorld() {
+            terrain = std::make_shared<Terrain>(threadPool);
+            terrain->setChunkFactory(std::make_shared<MockChunkFactory>());
+            terrain->initialize(std::make_shared<TerrainNoiseFactory>(), nullptr);
+        }
+    };
+}
+
+TEST(InputRecordingTest, SavedRecordingReplaysToTheSameChecksums) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() /
+        ("input_recording_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + ".bin");
+
+    InputRecording recording;
+    {
+        HeadlessWorld world;
+        glm::vec3 spawn(8.0f, world.terrain->queryHeight(8.0f, 8.0f) + 20.0f, 8.0f);
+        Simulation simulation(world.terrain, spawn);
+        recording.begin(spawn);
+        for (int step = 0; step < 600; ++step) {
+            SimInput input;
+            input.forward = step % 200 < 150;
+            input.left = step > 300;
+            input.jump = step == 60;
+            input.toggleFly = step == 400;
+            input.flyUp = step > 400;
+            input.yaw = -90.0f + static_cast<float>(step) * 0.25f;
+            input.pitch = step >= 500 ? -45.0f : 0.0f;
+            input.liftHeld = step >= 500;
+            simulation.step(input);
+            recording.append(input, simulation.getChecksum());
+        }
+        ASSERT_TRUE(recording.save(path.string()));
+    }
+
+    InputRecording loaded;
+    ASSERT_TRUE(loaded.load(path.string()));
+    std::filesystem::remove(path);
+    ASSERT_EQ(loaded.size(), recording.size());
+    EXPECT_EQ(loaded.getSpawnPosition(), recording.getSpawnPosition());
+
+    HeadlessWorld world;
+    Simulation replay(world.terrain, loaded.getSpawnPosition());
+    for (size_t step = 0; step < loaded.size(); ++step) {
+        EXPECT_EQ(loaded.inputAt(step).jump, recording.inputAt(step).jump);
+        replay.step(loaded.inputAt(step));
+        ASSERT_EQ(replay.getChecksum(), recording.checksumAt(step)) << "diverged at step " << step;
+    }
+}
+
+TEST(InputRecordingTest, RejectsFilesThatAreNotRecordings) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "input_recording_test_garbage.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "definitely not a recording";
+    }
+    InputRecording recording;
+    EXPECT_FALSE(recording.load(path.string()));
+    EXPECT_FALSE(recording.load((path / "missing").string()));
+    std::filesystem::remove(path);
+    EXPECT_TRUE(recording.empty());
+}
+
+TEST(InputRecordingTest, RejectsStepCountsBeyondTheFile) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "input_recording_test_count.bin";
+    InputRecording recording;
+    recording.begin(glm::vec3(0.0f));
+    recording.append(SimInput{}, 1);
+    ASSERT_TRUE(recording.save(path.string()));
+
+    // Claim four billion steps in a file that holds one
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        uint32_t stepCount = 0xffffffffu;
+        file.seekp(12);
+        file.write(reinterpret_cast<const char*>(&stepCount), sizeof(stepCount));
+    }
+    InputRecording loaded;
+    EXPECT_FALSE(loaded.load(path.string()));
+    std::filesystem::remove(path);
+    EXPECT_TRUE(loaded.empty());
+}
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "ChunkConstants.h"
+#include "ChunkManager.h"
+#include "MemoryTracker.h"
+#include "MockChunkFactory.h"
+#include "Terrain.h"
+#include "TerrainNoiseFactory.h"
+#include "../mocks/MockTerrainThreadPool.h"
+
+TEST(MemoryTrackerTest, TrackedBytesReportsResizesAndReleasesOnDestruction) {
+    MemoryTracker& tracker = MemoryTracker::getInstance();
+    size_t bytesBefore = tracker.getBytes(MemoryCategory::ModelCpu);
+    size_t objectsBefore = tracker.getObjectCount(MemoryCategory::ModelCpu);
+    {
+        TrackedBytes tracked(MemoryCategory::ModelCpu);
+        tracked.set(4096);
+        tracked.set(1024);
+        EXPECT_EQ(tracker.getBytes(MemoryCategory::ModelCpu), bytesBefore + 1024);
+        EXPECT_EQ(tracker.getObjectCount(MemoryCategory::ModelCpu), objectsBefore + 1);
+        EXPECT_GE(tracker.getPeakBytes(MemoryCategory::ModelCpu), bytesBefore + 4096);
+    }
+    EXPECT_EQ(tracker.getBytes(MemoryCategory::ModelCpu), bytesBefore);
+    EXPECT_EQ(tracker.getObjectCount(MemoryCategory::ModelCpu), objectsBefore);
+}
+
+TEST(MemoryTrackerTest, ChunkManagerEvictsToStayWithinByteBudget) {
+    MockTerrainThreadPool threadPool;
+    auto terrain = std::make_shared<Terrain>(threadPool);
+    terrain->setChunkFactory(std::make_shared<MockChunkFactory>());
+    terrain->initialize(std::make_shared<TerrainNoiseFactory>(), nullptr);
+
+    // Generated chunks report their CPU buffers
+    size_t chunkBytes = ChunkManager::getAverageChunkBytes();
+    EXPECT_GT(MemoryTracker::getInstance().getBytes(MemoryCategory::ChunkCpu), 0u);
+    EXPECT_GT(chunkBytes, 0u);
+
+    const size_t budget = chunkBytes * 10;
+    ChunkManager manager(threadPool, budget);
+    manager.setTerrain(terrain);
+    manager.updateLoadedChunks(glm::vec3(0.0f), 4.0f * ChunkConstants::SIZE);  // ~50 chunks in view
+
+    EXPECT_GT(manager.getLoadedChunkCount(), 0u);
+    EXPECT_LE(manager.getLoadedChunkCount(), 10u);
+    EXPECT_LE(manager.getResidentBytes(), budget + chunkBytes / 2);  // Average vs exact sizes
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "GpuTimer.h"
+#include "Profiler.h"
+
+namespace {
+    const Profiler::ScopeStats* findScope(const std::vector<Profiler::ScopeStats>& stats, const std::string& name) {
+        for (const auto& s : stats) {
+            if (s.name == name) return &s;
+        }
+        return nullptr;
+    }
+}
+
+TEST(ProfilerTest, AggregatesScopesFromEveryThreadPerFrame) {
+    Profiler& profiler = Profiler::getInstance();
+    profiler.endFrame();  // Drain anything earlier tests left behind
+
+    auto work = [] {
+        for (int i = 0; i < 3; ++i) {
+            PROFILE_SCOPE("ProfilerTest::work");
+        }
+    };
+    std::thread worker(work);
+    work();
+    worker.join();
+    profiler.endFrame();
+
+    auto stats = profiler.getStats();
+    const auto* scope = findScope(stats, "ProfilerTest::work");
+    ASSERT_NE(scope, nullptr);
+    EXPECT_EQ(scope->callsLastFrame, 6u);
+
+    profiler.endFrame();  // A frame without the scope records zero
+    stats = profiler.getStats();
+    scope = findScope(stats, "ProfilerTest::work");
+    ASSERT_NE(scope, nullptr);
+    EXPECT_EQ(scope->callsLastFrame, 0u);
+}
+
+TEST(ProfilerTest, TraceExportContainsCapturedEvents) {
+    Profiler& profiler = Profiler::getInstance();
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "profiler_test_trace.json";
+
+    profiler.startTrace();
+    {
+        PROFILE_SCOPE("ProfilerTest::traced");
+    }
+    profiler.endFrame();
+    ASSERT_TRUE(profiler.stopTrace(path.string()));
+    EXPECT_FALSE(profiler.isTracing());
+
+    std::ifstream in(path);
+    std::stringstream json;
+    json << in.rdbuf();
+    EXPECT_NE(json.str().find("\"name\":\"ProfilerTest::traced\",\"ph\":\"X\""), std::string::npos);
+    std::filesystem::remove(path);
+}
+
+TEST(ProfilerTest, RecordedValuesShareTheStatsSurface) {
+    Profiler& profiler = Profiler::getInstance();
+    profiler.endFrame();
+
+    // Without initialize() (no GL context) the GPU timer must be a silent no-op
+    GpuTimer gpuTimer;
+    gpuTimer.beginFrame();
+    {
+        GpuTimer::Scope scope(gpuTimer, "GPU::test");
+    }
+    EXPECT_FALSE(gpuTimer.isSupported());
+
+    profiler.recordValue("ProfilerTest::gpu", 2.0);
+    profiler.endFrame();
+    profiler.recordValue("ProfilerTest::gpu", 4.0);
+    profiler.endFrame();
+
+    auto stats = profiler.getStats();
+    const auto* gpu = findScope(stats, "ProfilerTest::gpu");
+    ASSERT_NE(gpu, nullptr);
+    EXPECT_DOUBLE_EQ(gpu->lastMs, 4.0);
+    EXPECT_DOUBLE_EQ(gpu->avgMs, 3.0);
+    EXPECT_DOUBLE_EQ(gpu->maxMs, 4.0);
+    EXPECT_EQ(findScope(stats, "GPU::test"), nullptr);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "MockChunkFactory.h"
+#include "Simulation.h"
+#include "Terrain.h"
+#include "TerrainNoiseFactory.h"
+#include "TerrainThreadPool.h"
+#include "../mocks/MockTerrainThreadPool.h"
+
+namespace {
+    // Walk, jump, aim down and hold for a glob lift, then charge and release the slingshot
+    SimInput scriptedInput(int step) {
+        SimInput input;
+        input.forward = step < 120;
+        input.jump = step == 40;
+        input.pitch = step >= 150 ? -60.0f : 0.0f;
+        input.liftHeld = step >= 150 && step < 400;
+        input.slingshotHeld = step >= 450 && step < 500;
+        input.cursorY = step >= 450 ? static_cast<float>(step - 450) * 4.0f : 0.0f;
+        return input;
+    }
+
+    struct HeadlessGame {
+        MockTerrainThreadPool threadPool;
+        std::shared_ptr<Terrain> terrain;
+        std::unique_ptr<Simulation> simulation;
+
+        HeadlessGame() {
+            terrain = std::make_shared<Terrain>(threadPool);
+            terrain->setChunkFactory(std::make_shared<MockChunkFactory>());
+            terrain->initialize(std::make_shared<TerrainNoiseFactory>(), nullptr);
+            glm::vec3 spawn(8.0f, terrain->queryHeight(8.0f, 8.0f) + 20.0f, 8.0f);
+            simulation = std::make_unique<Simulation>(terrain, spawn);
+        }
+    };
+}
+
+TEST(SimulationTest, SameInputsGiveIdenticalStates) {
+    HeadlessGame first;
+    HeadlessGame second;
+    ASSERT_EQ(first.simulation->getChecksum(), second.simulation->getChecksum());
+
+    bool sawGlob = false;
+    for (int step = 0; step < 3000; ++step) {
+        first.simulation->step(scriptedInput(step));
+        second.simulation->step(scriptedInput(step));
+        ASSERT_EQ(first.simulation->getChecksum(), second.simulation->getChecksum()) << "diverged at step " << step;
+        sawGlob |= !first.simulation->getState().globs.empty();
+    }
+    EXPECT_EQ(first.simulation->getStepCount(), 3000u);
+    EXPECT_TRUE(sawGlob);
+}
+
+TEST(SimulationTest, InterpolatesBetweenTheLastTwoSteps) {
+    HeadlessGame game;
+    SimInput walk;
+    walk.forward = true;
+    game.simulation->step(walk);
+    glm::vec3 before = game.simulation->getState().playerPosition;
+    game.simulation->step(walk);
+    glm::vec3 after = game.simulation->getState().playerPosition;
+
+    EXPECT_EQ(game.simulation->interpolate(0.0f).playerPosition, before);
+    EXPECT_EQ(game.simulation->interpolate(1.0f).playerPosition, after);
+    glm::vec3 halfway = game.simulation->interpolate(0.5f).playerPosition;
+    EXPECT_NEAR(halfway.z, (before.z + after.z) * 0.5f, 1e-4f);
+}
+
+TEST(SimulationTest, WorkerRemeshingAndStreamingDoNotChangeOutcomes) {
+    HeadlessGame reference;  // Inline pool: edits remesh immediately and nothing streams
+
+    std::shared_ptr<Terrain> terrain;  // Outlives the workers, which may still be generating its chunks
+    TerrainThreadPool workers(2);
+    terrain = std::make_shared<Terrain>(workers);
+    terrain->setChunkFactory(std::make_shared<MockChunkFactory>());
+    terrain->initialize(std::make_shared<TerrainNoiseFactory>(), nullptr);
+    Simulation streamed(terrain, reference.simulation->getState().playerPosition);
+
+    // Walk several chunks, digging globs out of the ground ahead and walking over the craters
+    auto input = [](int step) {
+        SimInput in;
+        bool lifting = (step >= 300 && step < 560) || (step >= 1500 && step < 1760);
+        in.forward = !lifting;
+        in.pitch = lifting ? -60.0f : 0.0f;
+        in.liftHeld = lifting;
+        in.moveSpeed = 12.0f;
+        return in;
+    };
+
+    bool sawGlob = false;
+    for (int step = 0; step < 2400; ++step) {
+        reference.simulation->step(input(step));
+        streamed.step(input(step));
+        glm::vec3 position = streamed.getState().playerPosition;
+        terrain->updateChunksAroundPlayer(position.x, position.z);
+        workers.processUploads();
+        ASSERT_EQ(reference.simulation->getChecksum(), streamed.getChecksum()) << "diverged at step " << step;
+        sawGlob |= !streamed.getState().globs.empty();
+    }
+    EXPECT_TRUE(sawGlob);
+    EXPECT_GT(terrain->getStreamingStats().chunksLoaded, 0u);
+}
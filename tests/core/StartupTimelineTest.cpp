@@ -0,0 +1,25 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "StartupTimeline.h"
+
+TEST(StartupTimelineTest, ReportsPhasesInOrderAndFlagsDeferredWork) {
+    StartupTimeline& timeline = StartupTimeline::getInstance();
+    {
+        STARTUP_PHASE("test: critical");
+    }
+    timeline.markFirstFrame();
+    double firstFrameMs = timeline.getFirstFrameMs();
+    timeline.markFirstFrame();  // Later frames do not move it
+    EXPECT_DOUBLE_EQ(timeline.getFirstFrameMs(), firstFrameMs);
+
+    std::thread worker([] { STARTUP_PHASE("test: deferred"); });
+    worker.join();
+
+    std::string report = timeline.formatReport();
+    size_t critical = report.find("test: critical");
+    size_t deferred = report.find("test: deferred (deferred) [worker]");
+    ASSERT_NE(critical, std::string::npos);
+    ASSERT_NE(deferred, std::string::npos);
+    EXPECT_LT(critical, deferred);
+    EXPECT_EQ(report.find("test: critical (deferred)"), std::string::npos);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include "ChunkCache.h"
+#include "ChunkConstants.h"
+
+class ChunkCacheTest : public ::testing::Test {
+protected:
+    std::filesystem::path root;
+
+    void SetUp() override {
+        root = std::filesystem::temp_directory_path() /
+               ("chunk_cache_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+        std::filesystem::remove_all(root);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(root);
+    }
+
+    static std::vector<float> makeHeights(float offset) {
+        const int side = ChunkConstants::SIZE + 1;
+        std::vector<float> heights(side * side);
+        for (int i = 0; i < side * side; ++i) {
+            heights[i] = offset + std::sin(i * 0.05f) * 12.5f;
+        }
+        return heights;
+    }
+};
+
+TEST_F(ChunkCacheTest, EncodingRoundTripsExactly) {
+    std::vector<float> heights = makeHeights(3.0f);
+    heights[7] = heights[6];  // Flat run
+    heights[8] = -0.0f;
+
+    std::vector<uint8_t> encoded;
+    ChunkCache::encodeHeights(heights, encoded);
+    EXPECT_LT(encoded.size(), heights.size() * sizeof(float));
+
+    std::pmr::vector<float> decoded;
+    ASSERT_TRUE(ChunkCache::decodeHeights(encoded.data(), encoded.size(), decoded));
+    ASSERT_EQ(decoded.size(), heights.size());
+    for (size_t i = 0; i < heights.size(); ++i) {
+        EXPECT_EQ(std::memcmp(&decoded[i], &heights[i], sizeof(float)), 0) << "index " << i;
+    }
+}
+
+TEST_F(ChunkCacheTest, StoredChunksSurviveReopen) {
+    auto first = makeHeights(1.0f);
+    auto second = makeHeights(-40.0f);
+    {
+        ChunkCache cache(root.string(), 42);
+        std::pmr::vector<float> out;
+        EXPECT_FALSE(cache.load(5, -3, out));
+
+        cache.store(5, -3, first);
+        cache.store(-33, 70, second);  // Different region
+        cache.flush();
+        EXPECT_TRUE(cache.load(5, -3, out));
+        EXPECT_TRUE(std::equal(out.begin(), out.end(), first.begin(), first.end()));
+    }
+
+    ChunkCache reopened(root.string(), 42);
+    std::pmr::vector<float> out;
+    ASSERT_TRUE(reopened.load(-33, 70, out));
+    EXPECT_TRUE(std::equal(out.begin(), out.end(), second.begin(), second.end()));
+    EXPECT_EQ(reopened.getStats().hits, 1u);
+}
+
+TEST_F(ChunkCacheTest, DifferentWorldKeyMisses) {
+    {
+        ChunkCache cache(root.string(), 1);
+        cache.store(0, 0, makeHeights(0.0f));
+        cache.flush();
+    }
+    ChunkCache other(root.string(), 2);
+    std::pmr::vector<float> out;
+    EXPECT_FALSE(other.load(0, 0, out));
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <utility>
+#include "ChunkGrid.h"
+#include "Terrain.h"
+#include "TerrainNoiseFactory.h"
+#include "MockChunkFactory.h"
+#include "../mocks/MockTerrainThreadPool.h"
+
+class ChunkGridTest : public ::testing::Test {
+protected:
+    std::shared_ptr<Terrain> terrain;
+    std::unique_ptr<MockTerrainThreadPool> threadPool;
+    MockChunkFactory factory;
+
+    void SetUp() override {
+        threadPool = std::make_unique<MockTerrainThreadPool>();
+        terrain = std::make_shared<Terrain>(*threadPool);
+        terrain->setChunkFactory(std::make_shared<MockChunkFactory>());
+        terrain->initialize(std::make_shared<TerrainNoiseFactory>(), nullptr);
+    }
+
+    std::shared_ptr<Chunk> makeChunk(int x, int z) {
+        return factory.createChunk(x, z, terrain);
+    }
+};
+
+TEST_F(ChunkGridTest, StoresAndFindsChunksInsideWindow) {
+    ChunkGrid grid(2);
+    auto chunk = makeChunk(-2, 1);
+
+    EXPECT_TRUE(grid.set(-2, 1, chunk));
+    EXPECT_EQ(grid.get(-2, 1), chunk);
+    EXPECT_EQ(grid.get(3, 1), nullptr);   // Same slot modulo 5, outside the window
+    EXPECT_FALSE(grid.set(3, 1, chunk));
+    EXPECT_EQ(grid.size(), 1u);
+}
+
+TEST_F(ChunkGridTest, RecenterEvictsOnlyScrolledOutEdge) {
+    ChunkGrid grid(1);
+    for (int z = -1; z <= 1; ++z) {
+        for (int x = -1; x <= 1; ++x) {
+            grid.set(x, z, makeChunk(x, z));
+        }
+    }
+
+    std::set<std::pair<int, int>> evicted;
+    grid.recenter(1, 0, [&](int x, int z, std::shared_ptr<Chunk>) {
+        evicted.insert({x, z});
+    });
+
+    std::set<std::pair<int, int>> expected{{-1, -1}, {-1, 0}, {-1, 1}};
+    EXPECT_EQ(evicted, expected);
+    EXPECT_EQ(grid.size(), 6u);
+    EXPECT_NE(grid.get(0, 0), nullptr);
+    EXPECT_EQ(grid.get(2, 0), nullptr);   // Reused slot is empty until loaded
+}
+
+TEST_F(ChunkGridTest, LargeJumpEvictsEverything) {
+    ChunkGrid grid(1);
+    grid.set(0, 0, makeChunk(0, 0));
+    grid.set(1, 1, makeChunk(1, 1));
+
+    int evictedCount = 0;
+    grid.recenter(-40, 25, [&](int, int, std::shared_ptr<Chunk>) { ++evictedCount; });
+
+    EXPECT_EQ(evictedCount, 2);
+    EXPECT_EQ(grid.size(), 0u);
+}
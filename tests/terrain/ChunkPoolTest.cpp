@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include "Chunk.h"
+#include "ChunkConstants.h"
+#include "ChunkManager.h"
+#include "ChunkPool.h"
+#include "ChunkStreamTracker.h"
+#include "MockChunkFactory.h"
+#include "Terrain.h"
+#include "TerrainNoiseFactory.h"
+#include "TerrainThreadPool.h"
+#include "../mocks/MockTerrainThreadPool.h"
+
+namespace {
+    // Only allocations made by the measuring thread count (the log writer thread runs concurrently)
+    thread_local bool countAllocations = false;
+    thread_local size_t allocationCount = 0;
+}
+
+void* operator new(std::size_t size) {
+    if (countAllocations) ++allocationCount;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+// ScratchArena falls back to aligned new when disabled, so those count too
+void* operator new(std::size_t size, std::align_val_t align) {
+    if (countAllocations) ++allocationCount;
+    size_t alignment = static_cast<size_t>(align);
+    if (void* p = std::aligned_alloc(alignment, (std::max<size_t>(size, 1) + alignment - 1) & ~(alignment - 1))) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+    // Pool-backed headless chunks: generated for real, but never uploaded to GL
+    class PooledHeadlessFactory : public IChunkFactory {
+    public:
+        std::shared_ptr<Chunk> createChunk(int x, int z, const std::shared_ptr<Terrain>& terrain) override {
+            return pool.acquire(x, z, terrain, false);
+        }
+        void releaseChunk(const std::shared_ptr<Chunk>& chunk) override { pool.release(chunk); }
+        ChunkPool pool;
+    };
+}
+
+class ChunkPoolTest : public ::testing::Test {
+protected:
+    MockTerrainThreadPool threadPool;
+    std::shared_ptr<Terrain> terrain;
+
+    void SetUp() override {
+        terrain = std::make_shared<Terrain>(threadPool);
+        terrain->setChunkFactory(std::make_shared<MockChunkFactory>());
+        terrain->initialize(std::make_shared<TerrainNoiseFactory>(), nullptr);
+    }
+};
+
+TEST_F(ChunkPoolTest, ReleasedChunkIsReusedWithItsCapacity) {
+    ChunkPool pool;
+    auto chunk = pool.acquire(0, 0, terrain, false);
+    chunk->generate();
+    Chunk* first = chunk.get();
+    size_t bytes = chunk->getMemoryBytes();
+    EXPECT_GT(bytes, 0u);
+
+    pool.release(chunk);  // Unloaded, but a worker still holds it
+    auto other = pool.acquire(1, 0, terrain, false);
+    EXPECT_NE(other.get(), first);
+
+    chunk.reset();
+    auto recycled = pool.acquire(4, -2, terrain, false);
+    EXPECT_EQ(recycled.get(), first);
+    EXPECT_EQ(recycled->getMemoryBytes(), bytes);  // Vectors kept their capacity
+    EXPECT_EQ(pool.getCreatedCount(), 2u);
+    EXPECT_EQ(pool.getReusedCount(), 1u);
+}
+
+// Streams through Terrain::updateChunksAroundPlayer, the path the game runs: ChunkManager
+// bookkeeping, the pool, the generation queue, generate() and the upload queue. The GL
+// upload itself needs a context; its interleaved copy comes from the scratch arena.
+TEST_F(ChunkPoolTest, SteadyStateStreamingDoesNotAllocate) {
+    auto factory = std::make_shared<PooledHeadlessFactory>();
+    TerrainThreadPool pool(0);  // Work runs on this thread, where allocations are counted
+    auto streamed = std::make_shared<Terrain>(pool);
+    streamed->setChunkFactory(factory);
+    streamed->initialize(std::make_shared<TerrainNoiseFactory>(), nullptr);
+    streamed->setMemoryBudget(size_t(1) << 40);
+
+    auto drain = [&] {
+        pool.runPendingTasks();
+        while (pool.getPendingUploadCount() > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(4));  // processUploads paces itself
+            pool.processUploads();
+        }
+    };
+
+    // Walk 2 chunks east and back
+    auto walk = [&] {
+        for (int step = 0; step <= 4; ++step) {
+            int chunkX = step <= 2 ? step : 4 - step;
+            streamed->updateChunksAroundPlayer((chunkX + 0.5f) * ChunkConstants::SIZE, 0.5f * ChunkConstants::SIZE);
+            drain();
+        }
+    };
+
+    for (int i = 0; i < 3; ++i) walk();  // Warm up: pool, queues, LRU nodes and vectors reach their peak size
+
+    size_t createdBefore = factory->pool.getCreatedCount();
+    size_t reusedBefore = factory->pool.getReusedCount();
+    uint64_t loadedBefore = streamed->getStreamingStats().chunksLoaded;
+    allocationCount = 0;
+    countAllocations = true;
+    walk();
+    countAllocations = false;
+    uint64_t loaded = streamed->getStreamingStats().chunksLoaded - loadedBefore;
+
+    EXPECT_GT(loaded, 0u);
+    EXPECT_EQ(allocationCount, 0u);
+    EXPECT_EQ(factory->pool.getCreatedCount(), createdBefore);
+    EXPECT_EQ(factory->pool.getReusedCount() - reusedBefore, loaded);
+}
+
+TEST_F(ChunkPoolTest, BudgetKeepsChunksInViewAndRetriesMisses) {
+    const float viewDistance = 2.0f * ChunkConstants::SIZE;
+    auto centre = [](int chunkX) { return glm::vec3((chunkX + 0.5f) * ChunkConstants::SIZE, 0.0f, 0.5f * ChunkConstants::SIZE); };
+    auto countMissingInView = [&](ChunkManager& manager, int chunkX) {
+        ChunkStreamTracker::Delta disk;
+        ChunkStreamTracker tracker;
+        tracker.update(chunkX, 0, viewDistance / ChunkConstants::SIZE, disk);
+        size_t missing = 0;
+        for (const auto& [x, z] : disk.entering) missing += manager.findChunk(x, z) == nullptr;
+        return std::make_pair(missing, disk.entering.size());
+    };
+
+    // Room for exactly the view disk: moving one chunk must evict what left view, not the spawn chunks
+    ChunkManager manager(threadPool, 0, 16);
+    manager.setTerrain(terrain);
+    size_t diskSize = countMissingInView(manager, 0).second;
+    const size_t chunkBytes = ChunkManager::getAverageChunkBytes();
+    manager.setMemoryBudget(diskSize * chunkBytes + chunkBytes / 2);
+    manager.updateLoadedChunks(centre(0), viewDistance);
+    manager.updateLoadedChunks(centre(1), viewDistance);
+    EXPECT_EQ(countMissingInView(manager, 1).first, 0u);
+    EXPECT_FALSE(manager.hasMissingChunks());
+
+    // Too small for the disk: the rim waits, then loads once the budget allows it
+    ChunkManager small(threadPool, (diskSize - 3) * chunkBytes + chunkBytes / 2, 16);
+    small.setTerrain(terrain);
+    small.updateLoadedChunks(centre(0), viewDistance);
+    EXPECT_EQ(countMissingInView(small, 0).first, 3u);
+    EXPECT_TRUE(small.hasMissingChunks());
+    EXPECT_NE(small.findChunk(0, 0), nullptr);
+
+    small.setMemoryBudget(size_t(1) << 40);
+    small.updateLoadedChunks(centre(0), viewDistance);
+    EXPECT_EQ(countMissingInView(small, 0).first, 0u);
+    EXPECT_FALSE(small.hasMissingChunks());
+}
+
+TEST_F(ChunkPoolTest, ChunkIsGeneratedOnceAndUnloadWins) {
+    Chunk chunk(5, 5, terrain, false);
+    EXPECT_EQ(chunk.getState(), Chunk::State::Empty);
+    EXPECT_EQ(chunk.getMemoryBytes(), 0u);  // Construction does no mesh work
+
+    EXPECT_TRUE(chunk.requestGeneration());
+    EXPECT_FALSE(chunk.requestGeneration());
+    chunk.generate();
+    EXPECT_EQ(chunk.getState(), Chunk::State::Generated);
+    EXPECT_FALSE(chunk.requestGeneration());
+
+    Chunk unloaded(6, 5, terrain, false);
+    EXPECT_TRUE(unloaded.requestGeneration());
+    unloaded.markUnloaded();
+    unloaded.generate();  // A worker that already started must not resurrect it
+    EXPECT_EQ(unloaded.getState(), Chunk::State::Unloaded);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <utility>
+#include "ChunkStreamTracker.h"
+
+namespace {
+    using CoordSet = std::set<std::pair<int, int>>;
+
+    CoordSet bruteForceDisk(int cx, int cz, float radius) {
+        CoordSet disk;
+        int r = static_cast<int>(radius) + 1;
+        for (int z = cz - r; z <= cz + r; ++z) {
+            for (int x = cx - r; x <= cx + r; ++x) {
+                float dx = static_cast<float>(x - cx);
+                float dz = static_cast<float>(z - cz);
+                if (dx * dx + dz * dz <= radius * radius) disk.insert({x, z});
+            }
+        }
+        return disk;
+    }
+
+    CoordSet difference(const CoordSet& a, const CoordSet& b) {
+        CoordSet out;
+        for (const auto& c : a) {
+            if (!b.count(c)) out.insert(c);
+        }
+        return out;
+    }
+}
+
+TEST(ChunkStreamTrackerTest, FirstUpdateLoadsWholeDisk) {
+    ChunkStreamTracker tracker;
+    ChunkStreamTracker::Delta delta;
+    tracker.update(0, 0, 10.0f, delta);
+
+    CoordSet entering(delta.entering.begin(), delta.entering.end());
+    EXPECT_EQ(entering, bruteForceDisk(0, 0, 10.0f));
+    EXPECT_TRUE(delta.leaving.empty());
+    EXPECT_EQ(delta.entering.front(), std::make_pair(0, 0));  // Nearest first
+}
+
+TEST(ChunkStreamTrackerTest, MovesMatchBruteForceDifference) {
+    ChunkStreamTracker tracker;
+    ChunkStreamTracker::Delta delta;
+    tracker.update(0, 0, 10.0f, delta);
+
+    const std::pair<int, int> path[] = {{1, 0}, {2, 1}, {2, 1}, {-3, 4}, {40, -40}, {41, -40}};
+    int lastX = 0, lastZ = 0;
+    for (const auto& [x, z] : path) {
+        tracker.update(x, z, 10.0f, delta);
+
+        CoordSet before = bruteForceDisk(lastX, lastZ, 10.0f);
+        CoordSet after = bruteForceDisk(x, z, 10.0f);
+        EXPECT_EQ(CoordSet(delta.entering.begin(), delta.entering.end()), difference(after, before));
+        EXPECT_EQ(CoordSet(delta.leaving.begin(), delta.leaving.end()), difference(before, after));
+        lastX = x;
+        lastZ = z;
+    }
+}
+
+TEST(ChunkStreamTrackerTest, SingleStepCostIsProportionalToBoundary) {
+    ChunkStreamTracker tracker;
+    ChunkStreamTracker::Delta delta;
+    tracker.update(0, 0, 32.0f, delta);
+    tracker.update(1, 0, 32.0f, delta);
+
+    // One column-shaped strip per row of the disk
+    EXPECT_EQ(delta.entering.size(), 65u);
+    EXPECT_EQ(delta.leaving.size(), 65u);
+    EXPECT_TRUE(tracker.isInView(33, 0));
+    EXPECT_FALSE(tracker.isInView(-32, 0));
+}
+
+TEST(ChunkStreamTrackerTest, RadiusChangeEmitsRing) {
+    ChunkStreamTracker tracker;
+    ChunkStreamTracker::Delta delta;
+    tracker.update(5, 5, 4.0f, delta);
+    tracker.update(5, 5, 6.0f, delta);
+
+    EXPECT_EQ(CoordSet(delta.entering.begin(), delta.entering.end()),
+              difference(bruteForceDisk(5, 5, 6.0f), bruteForceDisk(5, 5, 4.0f)));
+    EXPECT_TRUE(delta.leaving.empty());
+}
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <utility>
+#include <vector>
+#include "ChunkConstants.h"
+#include "GrassSpawner.h"
+
+TEST(GrassSpawnerTest, PlacesOnChunkHeightsWithoutDoublingSharedBorders) {
+    constexpr int SIZE = ChunkConstants::SIZE;
+    std::vector<float> heights((SIZE + 1) * (SIZE + 1));
+    for (int z = 0; z <= SIZE; ++z)
+        for (int x = 0; x <= SIZE; ++x)
+            heights[z * (SIZE + 1) + x] = static_cast<float>(x * 100 + z);  // Encodes the vertex it came from
+
+    std::set<std::pair<int, int>> seen;
+    for (int chunkX = -1; chunkX <= 1; ++chunkX) {
+        std::vector<glm::vec3> blades;
+        GrassSpawner::placeInChunk(chunkX, 0, heights.data(), blades);
+        EXPECT_LE(blades.size(), static_cast<size_t>(GrassSpawner::MAX_INSTANCES_PER_CHUNK));
+
+        for (const glm::vec3& blade : blades) {
+            int localX = static_cast<int>(blade.x) - chunkX * SIZE;
+            int localZ = static_cast<int>(blade.z);
+            ASSERT_GE(localX, 0);
+            ASSERT_LT(localX, SIZE);
+            ASSERT_LT(localZ, SIZE);
+            EXPECT_FLOAT_EQ(blade.y, static_cast<float>(localX * 100 + localZ));  // Reused, not resampled
+            EXPECT_TRUE(seen.emplace(static_cast<int>(blade.x), localZ).second);
+        }
+    }
+    EXPECT_FALSE(seen.empty());
+}
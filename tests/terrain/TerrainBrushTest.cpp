@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "ChunkConstants.h"
+#include "Terrain.h"
+#include "TerrainBrush.h"
+#include "TerrainNoiseFactory.h"
+#include "MockChunkFactory.h"
+#include "../mocks/MockTerrainThreadPool.h"
+
+TEST(TerrainBrushTest, CraterDigsBowlAndRaisesRim) {
+    BrushStroke stroke{BrushMode::Crater, 10.0f, 10.0f, 5.0f, 2.0f};
+    auto edits = TerrainBrush::computeEdits(stroke, nullptr);
+    ASSERT_FALSE(edits.empty());
+
+    auto at = [&](int x, int z) {
+        auto it = std::find_if(edits.begin(), edits.end(),
+                               [&](const auto& e) { return e.vertexX == x && e.vertexZ == z; });
+        return it != edits.end() ? it->delta : 0.0f;
+    };
+    EXPECT_FLOAT_EQ(at(10, 10), -2.0f);
+    EXPECT_GT(at(14, 10), 0.0f);   // Rim
+    EXPECT_EQ(at(15, 10), 0.0f);   // On the radius: untouched
+}
+
+TEST(TerrainBrushTest, SmoothPullsSpikeTowardNeighbours) {
+    auto spike = [](int x, int z) { return (x == 0 && z == 0) ? 8.0f : 0.0f; };
+    auto edits = TerrainBrush::computeEdits({BrushMode::Smooth, 0.0f, 0.0f, 1.5f, 1.0f}, spike);
+
+    auto centre = std::find_if(edits.begin(), edits.end(),
+                               [](const auto& e) { return e.vertexX == 0 && e.vertexZ == 0; });
+    ASSERT_NE(centre, edits.end());
+    EXPECT_FLOAT_EQ(centre->delta, -8.0f);
+}
+
+TEST(TerrainBrushTest, BrushUpdatesResidentChunksAcrossBorders) {
+    MockTerrainThreadPool threadPool;  // Runs remesh tasks inline
+    auto terrain = std::make_shared<Terrain>(threadPool);
+    terrain->setChunkFactory(std::make_shared<MockChunkFactory>());
+    terrain->initialize(std::make_shared<TerrainNoiseFactory>(), nullptr);
+
+    const int border = ChunkConstants::SIZE;  // Shared by spawn chunks (0, z) and (1, z)
+    float before = terrain->getVertexHeight(border, 5);
+    terrain->applyBrush({BrushMode::Raise, static_cast<float>(border), 5.0f, 2.0f, 3.0f});
+
+    EXPECT_FLOAT_EQ(terrain->getVertexHeight(border, 5), before + 3.0f);
+    auto left = terrain->getChunks().at({0, 0});
+    auto right = terrain->getChunks().at({1, 0});
+    EXPECT_FLOAT_EQ(left->getVertexHeight(ChunkConstants::SIZE, 5), before + 3.0f);
+    EXPECT_FLOAT_EQ(right->getVertexHeight(0, 5), before + 3.0f);
+}
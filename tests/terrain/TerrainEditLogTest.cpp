@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include "ChunkConstants.h"
+#include "TerrainEditLog.h"
+
+class TerrainEditLogTest : public ::testing::Test {
+protected:
+    static constexpr int SIZE = ChunkConstants::SIZE;
+    static constexpr uint64_t WORLD_KEY = 1337;
+    std::filesystem::path root;
+
+    void SetUp() override {
+        root = std::filesystem::temp_directory_path() /
+               ("terrain_edit_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+        std::filesystem::remove_all(root);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(root);
+    }
+
+    static std::pmr::vector<float> flatChunk() {
+        return std::pmr::vector<float>((SIZE + 1) * (SIZE + 1), 0.0f);
+    }
+};
+
+TEST_F(TerrainEditLogTest, BorderVertexReachesEveryChunkSharingIt) {
+    TerrainEditLog edits(root.string(), WORLD_KEY);
+    edits.addEdit(0, 0, -2.0f);
+    edits.addEdit(0, 0, -1.0f);
+    EXPECT_FLOAT_EQ(edits.getOffset(0, 0), -3.0f);
+
+    const std::pair<std::pair<int, int>, int> expected[] = {
+        {{0, 0}, 0},
+        {{-1, 0}, SIZE},
+        {{0, -1}, SIZE * (SIZE + 1)},
+        {{-1, -1}, SIZE * (SIZE + 1) + SIZE},
+    };
+    for (const auto& [chunk, index] : expected) {
+        std::pmr::vector<float> heights = flatChunk();
+        ASSERT_TRUE(edits.applyOverlay(chunk.first, chunk.second, heights));
+        EXPECT_FLOAT_EQ(heights[index], -3.0f);
+    }
+
+    std::pmr::vector<float> untouched = flatChunk();
+    EXPECT_FALSE(edits.applyOverlay(1, 1, untouched));
+}
+
+TEST_F(TerrainEditLogTest, CrashRecoveryReplaysLogAndDropsTornTail) {
+    std::string logPath;
+    {
+        TerrainEditLog edits(root.string(), WORLD_KEY);
+        edits.addEdit(5, 7, 1.5f);
+        edits.compact();
+        edits.addEdit(5, 7, 1.0f);
+        edits.addEdit(40, 3, 4.0f);
+        logPath = edits.getDirectory() + "/edits.wal";
+
+        // Simulate a crash: copy the log before the destructor compacts it
+        std::filesystem::copy_file(logPath, logPath + ".crash");
+    }
+    std::filesystem::rename(logPath + ".crash", logPath);
+
+    // Half a record written when the process died
+    {
+        std::ofstream torn(logPath, std::ios::binary | std::ios::app);
+        torn.write("\x01\x02\x03\x04\x05\x06", 6);
+    }
+
+    TerrainEditLog recovered(root.string(), WORLD_KEY);
+    EXPECT_EQ(recovered.getPendingRecordCount(), 2u);
+    EXPECT_FLOAT_EQ(recovered.getOffset(5, 7), 2.5f);  // Replay is idempotent over compacted state
+    EXPECT_FLOAT_EQ(recovered.getOffset(40, 3), 4.0f);
+    EXPECT_EQ(std::filesystem::file_size(logPath), 16u + 2u * 16u);
+}
+
+TEST_F(TerrainEditLogTest, CompactedEditsSurviveReopen) {
+    {
+        TerrainEditLog edits(root.string(), WORLD_KEY);
+        std::vector<TerrainEditLog::HeightEdit> brush;
+        for (int z = -3; z <= 3; ++z) {
+            for (int x = -3; x <= 3; ++x) {
+                brush.push_back({x + 64, z + 64, -1.0f});
+            }
+        }
+        edits.addEdits(brush);
+        edits.compact();
+        EXPECT_EQ(edits.getPendingRecordCount(), 0u);
+    }
+
+    TerrainEditLog reopened(root.string(), WORLD_KEY);
+    EXPECT_EQ(reopened.getPendingRecordCount(), 0u);
+    std::pmr::vector<float> heights = flatChunk();
+    ASSERT_TRUE(reopened.applyOverlay(2, 2, heights));
+    EXPECT_FLOAT_EQ(heights[0], -1.0f);          // Vertex (64, 64)
+    EXPECT_FLOAT_EQ(heights[4 * (SIZE + 1)], 0.0f);  // Vertex (64, 68) is outside the brush
+}
+
+TEST_F(TerrainEditLogTest, RepeatedCompactionKeepsRegionFilesBounded) {
+    std::string regionPath;
+    {
+        TerrainEditLog edits(root.string(), WORLD_KEY);
+        regionPath = edits.getDirectory() + "/e.0.0.trg";
+        std::vector<TerrainEditLog::HeightEdit> chunk;
+        for (int z = 1; z < SIZE; ++z) {
+            for (int x = 1; x < SIZE; ++x) {
+                chunk.push_back({x, z, 0.25f});
+            }
+        }
+        // Each round rewrites the whole chunk's payload; appending forever would pass 2 MB
+        for (int round = 0; round < 200; ++round) {
+            edits.addEdits(chunk);
+            edits.compact();
+        }
+        EXPECT_LT(std::filesystem::file_size(regionPath), 128u * 1024u);
+    }
+    EXPECT_FALSE(std::filesystem::exists(regionPath + ".tmp"));
+
+    TerrainEditLog reopened(root.string(), WORLD_KEY);
+    EXPECT_FLOAT_EQ(reopened.getOffset(1, 1), 50.0f);
+    EXPECT_FLOAT_EQ(reopened.getOffset(SIZE - 1, SIZE - 1), 50.0f);
+}
+
+TEST_F(TerrainEditLogTest, BackgroundCompactionKeepsEditsVisible) {
+    const int batches = static_cast<int>(TerrainEditLog::COMPACT_THRESHOLD / 64) * 3;
+    {
+        TerrainEditLog edits(root.string(), WORLD_KEY);
+        for (int batch = 0; batch < batches; ++batch) {
+            std::vector<TerrainEditLog::HeightEdit> brush;
+            for (int i = 0; i < 64; ++i) {
+                brush.push_back({i, batch, 1.0f});
+            }
+            edits.addEdits(brush);
+            // Whatever the compactor is doing, reads see every edit made so far
+            ASSERT_FLOAT_EQ(edits.getOffset(63, batch), 1.0f);
+            ASSERT_FLOAT_EQ(edits.getOffset(0, batch / 2), 1.0f);
+        }
+        edits.compact();
+        EXPECT_EQ(edits.getPendingRecordCount(), 0u);
+        EXPECT_FALSE(std::filesystem::exists(edits.getDirectory() + "/edits.wal.1"));
+    }
+
+    TerrainEditLog reopened(root.string(), WORLD_KEY);
+    for (int batch = 0; batch < batches; batch += 17) {
+        EXPECT_FLOAT_EQ(reopened.getOffset(batch % 64, batch), 1.0f);
+    }
+}
@@ -1,7 +1,12 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include "Chunk.h"
 #include "Terrain.h"
+#include "TerrainBrush.h"
 #include "TerrainNoiseFactory.h"
 #include "MockChunkFactory.h"
+#include "TerrainThreadPool.h"
 #include "../mocks/MockTerrainThreadPool.h"
 
 class TerrainTest : public ::testing::Test {
@@ -31,6 +36,23 @@ TEST_F(TerrainTest, TestInitialize) {
     EXPECT_GT(lastProgress, 0.0f);
 }
 
+TEST_F(TerrainTest, TestInitializeGeneratesSpawnAreaOnWorkers) {
+    TerrainThreadPool workers(2);
+    terrain = std::make_shared<Terrain>(workers);
+    terrain->setChunkFactory(std::make_shared<MockChunkFactory>());
+
+    std::vector<float> progress;
+    terrain->initialize(noiseFactory, [&](float value) { progress.push_back(value); });
+
+    // One report per finished chunk, ending at 1 once the whole area is ready
+    ASSERT_EQ(progress.size(), terrain->getChunks().size());
+    EXPECT_TRUE(std::is_sorted(progress.begin(), progress.end()));
+    EXPECT_FLOAT_EQ(progress.back(), 1.0f);
+    for (const auto& [coord, chunk] : terrain->getChunks()) {
+        EXPECT_EQ(chunk->getState(), Chunk::State::Generated);
+    }
+}
+
 TEST_F(TerrainTest, TestSurvivesConstruction) {
     terrain = std::make_shared<Terrain>(*threadPool);
     SUCCEED(); // No crash means pass
@@ -71,3 +93,122 @@ TEST_F(TerrainTest, TestInitializeGetHeightAt) {
     float height = terrain->getHeightAt(5.0f, 5.0f);
     EXPECT_GE(height, 0.0f);
 }
+
+TEST_F(TerrainTest, TestRaycastHitsResidentMeshExactly) {
+    terrain = std::make_shared<Terrain>(*threadPool);
+    terrain->setChunkFactory(std::make_shared<MockChunkFactory>());
+    terrain->initialize(noiseFactory, nullptr);
+
+    // Straight down onto a grid vertex lands on its height
+    float vertexHeight = terrain->getVertexHeight(5, 7);
+    auto down = terrain->raycast(glm::vec3(5.0f, vertexHeight + 50.0f, 7.0f), glm::vec3(0.0f, -1.0f, 0.0f), 100.0f);
+    ASSERT_TRUE(down.has_value());
+    EXPECT_NEAR(down->y, vertexHeight, 1e-3f);
+
+    // A slanted hit lies on the triangle under it (same diagonal split as the chunk mesh)
+    glm::vec3 origin(10.0f, terrain->getVertexHeight(10, 12) + 20.0f, 12.0f);
+    auto hit = terrain->raycast(origin, glm::vec3(1.0f, -0.5f, 0.6f), 200.0f);
+    ASSERT_TRUE(hit.has_value());
+    int x0 = static_cast<int>(std::floor(hit->x));
+    int z0 = static_cast<int>(std::floor(hit->z));
+    float fx = hit->x - x0, fz = hit->z - z0;
+    float h00 = terrain->getVertexHeight(x0, z0), h10 = terrain->getVertexHeight(x0 + 1, z0);
+    float h01 = terrain->getVertexHeight(x0, z0 + 1), h11 = terrain->getVertexHeight(x0 + 1, z0 + 1);
+    float surface = fx + fz <= 1.0f ? h00 + fx * (h10 - h00) + fz * (h01 - h00)
+                                    : h11 + (1.0f - fx) * (h01 - h11) + (1.0f - fz) * (h10 - h11);
+    EXPECT_NEAR(hit->y, surface, 1e-3f);
+
+    // Pointing away from the ground never hits
+    EXPECT_FALSE(terrain->raycast(origin, glm::vec3(0.0f, 1.0f, 0.0f), 200.0f).has_value());
+}
+
+TEST_F(TerrainTest, TestQueryHeightMatchesRenderedSurface) {
+    terrain = std::make_shared<Terrain>(*threadPool);
+    terrain->setChunkFactory(std::make_shared<MockChunkFactory>());
+    terrain->initialize(noiseFactory, nullptr);
+
+    // Resident: the mesh under the point, which a vertical ray also lands on
+    const glm::vec2 points[] = {{5.25f, 7.5f}, {-12.8f, 3.1f}, {31.9f, 32.0f}};
+    for (const glm::vec2& p : points) {
+        auto hit = terrain->raycast(glm::vec3(p.x, 500.0f, p.y), glm::vec3(0.0f, -1.0f, 0.0f), 1000.0f);
+        ASSERT_TRUE(hit.has_value());
+        EXPECT_NEAR(terrain->queryHeight(p.x, p.y), hit->y, 1e-3f);
+    }
+    EXPECT_FLOAT_EQ(terrain->queryHeight(5.0f, 7.0f), terrain->getVertexHeight(5, 7));
+
+    // Far outside the spawn area it falls back to noise
+    EXPECT_FLOAT_EQ(terrain->queryHeight(5000.5f, 5000.5f), terrain->getHeightAt(5000.5f, 5000.5f));
+}
+
+TEST_F(TerrainTest, TestRaycastBatchMatchesSingleRays) {
+    TerrainThreadPool workers(2);
+    terrain = std::make_shared<Terrain>(workers);
+    terrain->setChunkFactory(std::make_shared<MockChunkFactory>());
+    terrain->initialize(noiseFactory, nullptr);
+
+    // Spread over several chunks, out of chunk order, a few aimed at the sky
+    std::vector<Terrain::Ray> rays;
+    for (int i = 0; i < 150; ++i) {
+        float x = static_cast<float>((i * 37) % 120) - 60.0f;
+        float z = static_cast<float>((i * 53) % 120) - 60.0f;
+        float dirY = i % 10 == 0 ? 1.0f : -1.0f;
+        rays.push_back({glm::vec3(x, 300.0f, z), glm::vec3(0.3f, dirY, -0.2f), 1000.0f});
+    }
+
+    std::vector<Terrain::RayHit> hits(rays.size());
+    terrain->raycastBatch(rays.data(), rays.size(), hits.data());
+    for (size_t i = 0; i < rays.size(); ++i) {
+        auto expected = terrain->raycast(rays[i].origin, rays[i].direction, rays[i].maxDistance);
+        ASSERT_EQ(hits[i].hit, expected.has_value()) << "ray " << i;
+        if (expected) {
+            EXPECT_FLOAT_EQ(hits[i].point.y, expected->y);
+        }
+    }
+}
+
+TEST_F(TerrainTest, TestHeightEditsMoveGrassInTheEditedArea) {
+    terrain = std::make_shared<Terrain>(*threadPool);
+    terrain->setChunkFactory(std::make_shared<MockChunkFactory>());
+    terrain->initialize(noiseFactory, nullptr);
+
+    Chunk chunk(1, 0, terrain, true);  // Rendering enabled so blades are placed; never uploaded
+    chunk.generate();
+    std::vector<glm::vec3> before = chunk.getGrassInstances();
+    ASSERT_FALSE(before.empty());
+
+    // Raise the chunk's west half
+    constexpr int SIZE = ChunkConstants::SIZE;
+    std::vector<Chunk::VertexDelta> deltas;
+    for (int z = 0; z <= SIZE; ++z)
+        for (int x = 0; x <= SIZE / 2; ++x)
+            deltas.push_back({x, z, 3.0f});
+    chunk.applyHeightDeltas(deltas, 1);
+
+    std::vector<glm::vec3> after;
+    ASSERT_TRUE(chunk.takeGrassEdits(after));
+    EXPECT_FALSE(chunk.takeGrassEdits(after));
+    ASSERT_EQ(after.size(), before.size());
+    for (size_t i = 0; i < after.size(); ++i) {
+        int localX = static_cast<int>(before[i].x) - SIZE;
+        float expected = before[i].y + (localX <= SIZE / 2 ? 3.0f : 0.0f);
+        EXPECT_FLOAT_EQ(after[i].y, expected);
+        EXPECT_FLOAT_EQ(after[i].y, chunk.getVertexHeight(localX, static_cast<int>(before[i].z)));
+    }
+}
+
+TEST_F(TerrainTest, TestUnloggedEditsReachChunksGeneratedLater) {
+    terrain = std::make_shared<Terrain>(*threadPool);
+    terrain->setChunkFactory(std::make_shared<MockChunkFactory>());
+    terrain->initialize(noiseFactory, nullptr);
+
+    // Far from the spawn area, so no resident chunk takes the stroke
+    const int vertexX = 4000, vertexZ = 4000;
+    float before = terrain->getEditedVertexHeight(vertexX, vertexZ);
+    terrain->applyBrush({BrushMode::Raise, static_cast<float>(vertexX), static_cast<float>(vertexZ), 3.0f, 2.0f});
+    EXPECT_FLOAT_EQ(terrain->getEditedVertexHeight(vertexX, vertexZ), before + 2.0f);
+
+    constexpr int SIZE = ChunkConstants::SIZE;
+    Chunk chunk(vertexX / SIZE, vertexZ / SIZE, terrain, false);
+    chunk.generate();
+    EXPECT_FLOAT_EQ(chunk.getVertexHeight(vertexX % SIZE, vertexZ % SIZE), before + 2.0f);
+}